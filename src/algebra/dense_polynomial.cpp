@@ -0,0 +1,324 @@
+#include "dense_polynomial.h"
+#include "polynomial.h"
+#include "../modular_arithmetic.h"
+#include "../cancellation.h"
+#include <algorithm>
+#include <stdexcept>
+#include <boost/multiprecision/integer.hpp>
+
+namespace Algebra {
+
+namespace {
+
+// 次数超过 项数 * 4 + 64 时认为多项式是稀疏的，不转换为稠密形式
+const size_t DENSE_MAX_GAP_FACTOR = 4;
+const size_t DENSE_MIN_DEGREE_LIMIT = 64;
+
+// 乘法按较短因子的长度分档：低于 KARATSUBA_THRESHOLD 用教科书卷积，
+// 低于 MODULAR_THRESHOLD 用 Karatsuba，再大则用多模数论变换（求值/插值）加中国剩余定理
+const size_t KARATSUBA_THRESHOLD = 32;
+const size_t MODULAR_THRESHOLD = 256;
+
+// 乘以所有分母的最小公倍数，得到整系数：coeffs = ints / 返回值
+BigInt toIntegerCoefficients(const std::vector<Fraction>& coeffs, std::vector<BigInt>& ints) {
+    BigInt scale = 1;
+    for (const auto& c : coeffs) {
+        const BigInt& den = c.getDenominator();
+        if (den != 1 && scale % den != 0) {
+            scale = scale / boost::multiprecision::gcd(scale, den) * den;
+        }
+    }
+    ints.resize(coeffs.size());
+    for (size_t k = 0; k < coeffs.size(); ++k) {
+        ints[k] = coeffs[k].getDenominator() == scale
+            ? coeffs[k].getNumerator()
+            : BigInt(coeffs[k].getNumerator() * (scale / coeffs[k].getDenominator()));
+    }
+    return scale;
+}
+
+// out[i + j] += a[i] * b[j]
+void schoolbookMultiplyAdd(const BigInt* a, size_t na, const BigInt* b, size_t nb, BigInt* out) {
+    for (size_t i = 0; i < na; ++i) {
+        if (a[i] == 0) {
+            continue;
+        }
+        for (size_t j = 0; j < nb; ++j) {
+            if (b[j] != 0) {
+                out[i + j] += a[i] * b[j];
+            }
+        }
+    }
+}
+
+// Karatsuba：a = a0 + x^m a1，b = b0 + x^m b1，
+// a b = z0 + x^m ((a0 + a1)(b0 + b1) - z0 - z2) + x^{2m} z2，三次递归乘法代替四次
+void karatsubaMultiplyAdd(const BigInt* a, size_t na, const BigInt* b, size_t nb, BigInt* out) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb < KARATSUBA_THRESHOLD) {
+        schoolbookMultiplyAdd(a, na, b, nb, out);
+        return;
+    }
+    const size_t m = (na + 1) / 2;
+    if (nb <= m) {
+        // 长短悬殊：把长因子切成与短因子等长的段，逐段相乘
+        for (size_t offset = 0; offset < na; offset += nb) {
+            karatsubaMultiplyAdd(a + offset, std::min(nb, na - offset), b, nb, out + offset);
+        }
+        return;
+    }
+
+    Cancellation::checkpoint();
+    const size_t na1 = na - m;
+    const size_t nb1 = nb - m;
+    std::vector<BigInt> z0(2 * m - 1), z1(2 * m - 1), z2(na1 + nb1 - 1);
+    karatsubaMultiplyAdd(a, m, b, m, z0.data());
+    karatsubaMultiplyAdd(a + m, na1, b + m, nb1, z2.data());
+
+    std::vector<BigInt> sumA(a, a + m), sumB(b, b + m);
+    for (size_t i = 0; i < na1; ++i) {
+        sumA[i] += a[m + i];
+    }
+    for (size_t i = 0; i < nb1; ++i) {
+        sumB[i] += b[m + i];
+    }
+    karatsubaMultiplyAdd(sumA.data(), m, sumB.data(), m, z1.data());
+    for (size_t i = 0; i < z0.size(); ++i) {
+        z1[i] -= z0[i];
+    }
+    for (size_t i = 0; i < z2.size(); ++i) {
+        z1[i] -= z2[i];
+    }
+
+    for (size_t i = 0; i < z0.size(); ++i) {
+        out[i] += z0[i];
+    }
+    for (size_t i = 0; i < z1.size(); ++i) {
+        out[m + i] += z1[i];
+    }
+    for (size_t i = 0; i < z2.size(); ++i) {
+        out[2 * m + i] += z2[i];
+    }
+}
+
+} // namespace
+
+DensePolynomial::DensePolynomial(std::vector<Fraction> coefficients) : coeffs(std::move(coefficients)) {
+    trim();
+}
+
+void DensePolynomial::trim() {
+    while (!coeffs.empty() && coeffs.back().getNumerator() == 0) {
+        coeffs.pop_back();
+    }
+}
+
+bool DensePolynomial::fromPolynomial(const Polynomial& p, DensePolynomial& out) {
+    const std::vector<Monomial>& terms = p.getTerms();
+    out.coeffs.clear();
+    if (terms.empty()) {
+        return true;
+    }
+    Fraction top(0);
+    for (const auto& term : terms) {
+        if (!term.coefficient.isRational() || term.power.getDenominator() != 1 || term.power < Fraction(0)) {
+            return false;
+        }
+        if (term.power > top) {
+            top = term.power;
+        }
+    }
+    if (top > Fraction(static_cast<long long>(terms.size() * DENSE_MAX_GAP_FACTOR + DENSE_MIN_DEGREE_LIMIT))) {
+        return false;
+    }
+
+    out.coeffs.assign(top.getNumerator().convert_to<size_t>() + 1, Fraction(0));
+    for (const auto& term : terms) {
+        Fraction& slot = out.coeffs[term.power.getNumerator().convert_to<size_t>()];
+        slot = slot + term.coefficient.getRationalValue();
+    }
+    out.trim();
+    return true;
+}
+
+Polynomial DensePolynomial::toPolynomial(const std::string& variable) const {
+    Polynomial result;
+    result.variable_name = variable;
+    for (size_t k = coeffs.size(); k-- > 0;) {
+        if (coeffs[k].getNumerator() != 0) {
+            result.terms.emplace_back(SimplifiedRadical(coeffs[k]), variable, Fraction(static_cast<long long>(k)));
+        }
+    }
+    return result;
+}
+
+int DensePolynomial::degree() const {
+    return static_cast<int>(coeffs.size()) - 1;
+}
+
+Fraction DensePolynomial::coefficient(size_t k) const {
+    return k < coeffs.size() ? coeffs[k] : Fraction(0);
+}
+
+DensePolynomial DensePolynomial::operator+(const DensePolynomial& other) const {
+    DensePolynomial result;
+    result.coeffs.resize(std::max(coeffs.size(), other.coeffs.size()));
+    for (size_t k = 0; k < result.coeffs.size(); ++k) {
+        if (k >= other.coeffs.size()) {
+            result.coeffs[k] = coeffs[k];
+        } else if (k >= coeffs.size()) {
+            result.coeffs[k] = other.coeffs[k];
+        } else {
+            result.coeffs[k] = coeffs[k] + other.coeffs[k];
+        }
+    }
+    result.trim();
+    return result;
+}
+
+DensePolynomial DensePolynomial::operator-(const DensePolynomial& other) const {
+    DensePolynomial result;
+    result.coeffs.resize(std::max(coeffs.size(), other.coeffs.size()));
+    for (size_t k = 0; k < result.coeffs.size(); ++k) {
+        if (k >= other.coeffs.size()) {
+            result.coeffs[k] = coeffs[k];
+        } else if (k >= coeffs.size()) {
+            result.coeffs[k] = -other.coeffs[k];
+        } else {
+            result.coeffs[k] = coeffs[k] - other.coeffs[k];
+        }
+    }
+    result.trim();
+    return result;
+}
+
+DensePolynomial DensePolynomial::operator*(const DensePolynomial& other) const {
+    if (coeffs.empty() || other.coeffs.empty()) {
+        return DensePolynomial();
+    }
+    DensePolynomial result;
+    result.coeffs.resize(coeffs.size() + other.coeffs.size() - 1);
+    const size_t shorter = std::min(coeffs.size(), other.coeffs.size());
+    if (shorter < KARATSUBA_THRESHOLD) {
+        // 逐个输出系数做卷积 c_k = sum a_i b_{k-i}，累加时延迟约分
+        for (size_t k = 0; k < result.coeffs.size(); ++k) {
+            size_t first = k >= other.coeffs.size() ? k - other.coeffs.size() + 1 : 0;
+            size_t last = std::min(k, coeffs.size() - 1);
+            RationalAccumulator acc;
+            for (size_t i = first; i <= last; ++i) {
+                if (coeffs[i].getNumerator() != 0 && other.coeffs[k - i].getNumerator() != 0) {
+                    acc.fma(coeffs[i], other.coeffs[k - i]);
+                }
+            }
+            result.coeffs[k] = acc.result();
+        }
+        result.trim();
+        return result;
+    }
+
+    // 次数较高时先通分为整系数多项式相乘，最后统一除以两个公分母之积
+    std::vector<BigInt> a, b, product;
+    BigInt scale = toIntegerCoefficients(coeffs, a) * toIntegerCoefficients(other.coeffs, b);
+    if (shorter < MODULAR_THRESHOLD) {
+        product.assign(result.coeffs.size(), BigInt(0));
+        karatsubaMultiplyAdd(a.data(), a.size(), b.data(), b.size(), product.data());
+    } else {
+        product = ModularOperations::integerPolynomialProduct(a, b);
+    }
+    for (size_t k = 0; k < product.size(); ++k) {
+        result.coeffs[k] = scale == 1 ? Fraction(product[k]) : Fraction(product[k], scale);
+    }
+    result.trim();
+    return result;
+}
+
+DensePolynomial DensePolynomial::operator*(const Fraction& scalar) const {
+    if (scalar.getNumerator() == 0) {
+        return DensePolynomial();
+    }
+    DensePolynomial result = *this;
+    for (auto& c : result.coeffs) {
+        c = c * scalar;
+    }
+    return result;
+}
+
+DensePolynomial DensePolynomial::pow(unsigned exp) const {
+    // 二进制快速幂：从低位到高位扫描指数，最后一次不再多做一次平方
+    DensePolynomial result(std::vector<Fraction>{Fraction(1)});
+    DensePolynomial base = *this;
+    while (exp > 0) {
+        if (exp & 1) {
+            result = result * base;
+        }
+        exp >>= 1;
+        if (exp > 0) {
+            base = base * base;
+        }
+    }
+    return result;
+}
+
+void DensePolynomial::divide(const DensePolynomial& divisor, DensePolynomial& quotient, DensePolynomial& remainder) const {
+    if (divisor.isZero()) {
+        throw std::invalid_argument("Polynomial division by zero.");
+    }
+    std::vector<Fraction> rem = coeffs;
+    const size_t m = divisor.coeffs.size();
+    const Fraction& lead = divisor.coeffs.back();
+    std::vector<Fraction> quot(rem.size() >= m ? rem.size() - m + 1 : 0, Fraction(0));
+    for (size_t k = quot.size(); k-- > 0;) {
+        Fraction q = rem[k + m - 1] / lead;
+        quot[k] = q;
+        if (q.getNumerator() == 0) {
+            continue;
+        }
+        for (size_t i = 0; i < m; ++i) {
+            if (divisor.coeffs[i].getNumerator() != 0) {
+                rem[k + i] = rem[k + i] - q * divisor.coeffs[i];
+            }
+        }
+    }
+    quotient = DensePolynomial(std::move(quot));
+    remainder = DensePolynomial(std::move(rem));
+}
+
+DensePolynomial DensePolynomial::gcd(DensePolynomial a, DensePolynomial b) {
+    DensePolynomial quotient, remainder;
+    while (!b.isZero()) {
+        Cancellation::checkpoint();
+        a.divide(b, quotient, remainder);
+        // 每步取首一，抑制有理系数的膨胀
+        a = std::move(b);
+        b = remainder.monic();
+    }
+    return a.monic();
+}
+
+DensePolynomial DensePolynomial::derivative() const {
+    std::vector<Fraction> result(coeffs.empty() ? 0 : coeffs.size() - 1);
+    for (size_t k = 1; k < coeffs.size(); ++k) {
+        result[k - 1] = coeffs[k] * Fraction(static_cast<long long>(k));
+    }
+    return DensePolynomial(std::move(result));
+}
+
+DensePolynomial DensePolynomial::monic() const {
+    if (coeffs.empty() || coeffs.back() == Fraction(1)) {
+        return *this;
+    }
+    return *this * (Fraction(1) / coeffs.back());
+}
+
+Fraction DensePolynomial::evaluate(const Fraction& x) const {
+    Fraction result(0);
+    for (size_t k = coeffs.size(); k-- > 0;) {
+        result = result * x + coeffs[k];
+    }
+    return result;
+}
+
+} // namespace Algebra
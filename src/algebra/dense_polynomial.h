@@ -0,0 +1,64 @@
+#ifndef ALGEBRA_DENSE_POLYNOMIAL_H
+#define ALGEBRA_DENSE_POLYNOMIAL_H
+
+#include "../fraction.h"
+#include <string>
+#include <vector>
+
+namespace Algebra {
+
+class Polynomial;
+
+/**
+ * @class DensePolynomial
+ * @brief 有理系数、非负整数次幂的单变量多项式的稠密表示。
+ *
+ * coefficients()[k] 为 x^k 的系数，最高次项系数非零（零多项式没有系数）。
+ * 加减为逐项 O(n)，乘法不经过 Polynomial::simplify 的按次幂分组合并，而是按规模选择
+ * 教科书卷积、Karatsuba 或多模数论变换（见 ModularOperations::integerPolynomialProduct）。
+ * 含根式系数或分数、负数次幂的多项式仍使用 Polynomial 的单项式表示。
+ */
+class DensePolynomial {
+public:
+    DensePolynomial() = default;
+    explicit DensePolynomial(std::vector<Fraction> coefficients);
+
+    // 能表示为稠密形式时写入 out 并返回 true：系数全为有理数、次幂为非负整数，
+    // 且次数不比项数大太多（x^100000 这类稀疏多项式仍用单项式表示）
+    static bool fromPolynomial(const Polynomial& p, DensePolynomial& out);
+
+    // 转换回单项式表示，结果与 Polynomial 化简后的形式相同（按降幂排列，省略零系数）
+    Polynomial toPolynomial(const std::string& variable) const;
+
+    int degree() const; // 零多项式为 -1
+    bool isZero() const { return coeffs.empty(); }
+    const std::vector<Fraction>& coefficients() const { return coeffs; }
+    Fraction coefficient(size_t k) const; // 超过次数时为 0
+
+    DensePolynomial operator+(const DensePolynomial& other) const;
+    DensePolynomial operator-(const DensePolynomial& other) const;
+    DensePolynomial operator*(const DensePolynomial& other) const;
+    DensePolynomial operator*(const Fraction& scalar) const;
+
+    // 二进制快速幂，pow(0) 为常数 1
+    DensePolynomial pow(unsigned exp) const;
+
+    // 带余除法 *this = quotient * divisor + remainder，divisor 为零时抛出 std::invalid_argument
+    void divide(const DensePolynomial& divisor, DensePolynomial& quotient, DensePolynomial& remainder) const;
+    // 首一的最大公因式（欧几里得算法），两者都为零时返回零多项式
+    static DensePolynomial gcd(DensePolynomial a, DensePolynomial b);
+    DensePolynomial derivative() const;
+    DensePolynomial monic() const; // 除以首项系数，零多项式保持不变
+
+    // 秦九韶（Horner）法求值
+    Fraction evaluate(const Fraction& x) const;
+
+private:
+    std::vector<Fraction> coeffs;
+
+    void trim(); // 去掉高次的零系数
+};
+
+} // namespace Algebra
+
+#endif // ALGEBRA_DENSE_POLYNOMIAL_H
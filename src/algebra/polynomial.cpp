@@ -1,6 +1,7 @@
 #include "polynomial.h"
 #include "../fraction.h"
 #include "radical.h"
+#include "dense_polynomial.h"
 #include <stdexcept>
 #include <sstream>
 #include <algorithm>
@@ -294,6 +295,18 @@ namespace Algebra
                 return Polynomial(Monomial(Fraction(1), var_name, Fraction(1)));
             }
         };
+
+        // 新增：稠密路径结果的变量名。常数（包括零多项式）可能带着先前运算留下的变量名，
+        // 因此优先取非常数一侧的变量名，两侧都不是常数时取左侧
+        const std::string &resultVariable(const Polynomial &lhs, const DensePolynomial &a,
+                                          const Polynomial &rhs, const DensePolynomial &b)
+        {
+            if (a.degree() > 0 && !lhs.getVariableName().empty())
+                return lhs.getVariableName();
+            if (b.degree() > 0 && !rhs.getVariableName().empty())
+                return rhs.getVariableName();
+            return lhs.getVariableName().empty() ? rhs.getVariableName() : lhs.getVariableName();
+        }
     } // anonymous namespace
 
     // Helper functions
@@ -400,6 +413,13 @@ namespace Algebra
 
     Polynomial Polynomial::operator+(const Polynomial &other) const
     {
+        // 新增：有理系数、整数次幂的多项式直接在稠密系数上运算，不经过 simplify，减法、乘法同
+        DensePolynomial a, b;
+        if (DensePolynomial::fromPolynomial(*this, a) && DensePolynomial::fromPolynomial(other, b))
+        {
+            return (a + b).toPolynomial(resultVariable(*this, a, other, b));
+        }
+
         Polynomial result = *this;
         for (const auto &term : other.terms)
         {
@@ -413,6 +433,12 @@ namespace Algebra
 
     Polynomial Polynomial::operator-(const Polynomial &other) const
     {
+        DensePolynomial a, b;
+        if (DensePolynomial::fromPolynomial(*this, a) && DensePolynomial::fromPolynomial(other, b))
+        {
+            return (a - b).toPolynomial(resultVariable(*this, a, other, b));
+        }
+
         Polynomial result = *this;
         for (const auto &term : other.terms)
         {
@@ -426,6 +452,12 @@ namespace Algebra
 
     Polynomial Polynomial::operator*(const Polynomial &other) const
     {
+        DensePolynomial a, b;
+        if (DensePolynomial::fromPolynomial(*this, a) && DensePolynomial::fromPolynomial(other, b))
+        {
+            return (a * b).toPolynomial(resultVariable(*this, a, other, b));
+        }
+
         Polynomial result;
         if (this->variable_name.empty() && !other.variable_name.empty())
         {
@@ -490,7 +522,14 @@ namespace Algebra
             return result;
         }
 
-        // 优化2: 对通用多项式使用快速幂（平方求幂）算法
+        // 优化2: 有理系数的稠密多项式直接在稠密形式上做快速幂，中间结果不再来回转换
+        DensePolynomial dense;
+        if (DensePolynomial::fromPolynomial(base, dense))
+        {
+            return dense.pow(static_cast<unsigned>(exp)).toPolynomial(base.variable_name);
+        }
+
+        // 优化3: 对通用多项式使用快速幂（平方求幂）算法
         Polynomial result("1");
         Polynomial current_power = base;
         int current_exp = exp;
@@ -501,8 +540,11 @@ namespace Algebra
             {
                 result = result * current_power;
             }
-            current_power = current_power * current_power;
             current_exp /= 2;
+            if (current_exp > 0)
+            {
+                current_power = current_power * current_power;
+            }
         }
         return result;
     }
@@ -627,6 +669,11 @@ namespace Algebra
         return terms;
     }
 
+    const std::string &Polynomial::getVariableName() const
+    {
+        return variable_name;
+    }
+
     std::vector<Polynomial> Polynomial::perform_factorization() const
     {
         if (!hasOnlyRationalCoefficients())
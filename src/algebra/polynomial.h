@@ -32,6 +32,7 @@ public:
     size_t getTermCount() const;
     Monomial getMonomial() const;
     const std::vector<Monomial>& getTerms() const;
+    const std::string& getVariableName() const; // 新增：主变量名，常数多项式可能为空
     std::vector<Polynomial> perform_factorization() const;
 
     // 新增：多项式除法和因式分解相关方法
@@ -44,6 +45,7 @@ public:
     std::vector<std::string> solve_all_roots() const; // 求解所有根
 
     friend Polynomial pow(const Polynomial& base, int exp);
+    friend class DensePolynomial; // 新增：稠密形式直接构造已化简的项
 
 private:
     std::vector<Monomial> terms;
@@ -0,0 +1,628 @@
+#include "polynomial_factoring.h"
+#include "../modular_arithmetic.h"
+#include "../cancellation.h"
+#include "../progress.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <boost/multiprecision/integer.hpp>
+
+namespace Algebra {
+
+namespace {
+
+using IntPoly = std::vector<BigInt>;   // 整系数，按升幂排列
+using ModPoly = std::vector<uint64_t>; // F_p 上的系数，按升幂排列，最高次系数非零
+
+// 依次尝试的“好”素数个数，取其中模 p 因子最少的一个，以减少组合试除的次数
+const size_t CANDIDATE_PRIMES = 5;
+
+// ---------- F_p 上的多项式运算 ----------
+
+void trim(ModPoly& a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+int degree(const ModPoly& a) {
+    return static_cast<int>(a.size()) - 1;
+}
+
+ModPoly subtract(const ModPoly& a, const ModPoly& b, const PrimeField& field) {
+    ModPoly result(std::max(a.size(), b.size()), 0);
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = field.sub(i < a.size() ? a[i] : 0, i < b.size() ? b[i] : 0);
+    }
+    trim(result);
+    return result;
+}
+
+ModPoly add(const ModPoly& a, const ModPoly& b, const PrimeField& field) {
+    ModPoly result(std::max(a.size(), b.size()), 0);
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = field.add(i < a.size() ? a[i] : 0, i < b.size() ? b[i] : 0);
+    }
+    trim(result);
+    return result;
+}
+
+ModPoly multiply(const ModPoly& a, const ModPoly& b, const PrimeField& field) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+    ModPoly result(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] == 0) {
+            continue;
+        }
+        for (size_t j = 0; j < b.size(); ++j) {
+            result[i + j] = field.add(result[i + j], field.mul(a[i], b[j]));
+        }
+    }
+    trim(result);
+    return result;
+}
+
+// a = q * b + r，b 非零
+void divide(const ModPoly& a, const ModPoly& b, ModPoly& q, ModPoly& r, const PrimeField& field) {
+    r = a;
+    if (a.size() < b.size()) {
+        q.clear();
+        return;
+    }
+    q.assign(a.size() - b.size() + 1, 0);
+    const uint64_t leadInv = field.inv(b.back());
+    for (size_t k = q.size(); k-- > 0;) {
+        uint64_t c = field.mul(r[k + b.size() - 1], leadInv);
+        q[k] = c;
+        if (c == 0) {
+            continue;
+        }
+        for (size_t i = 0; i < b.size(); ++i) {
+            r[k + i] = field.sub(r[k + i], field.mul(c, b[i]));
+        }
+    }
+    trim(q);
+    trim(r);
+}
+
+ModPoly remainder(const ModPoly& a, const ModPoly& b, const PrimeField& field) {
+    ModPoly q, r;
+    divide(a, b, q, r, field);
+    return r;
+}
+
+ModPoly quotient(const ModPoly& a, const ModPoly& b, const PrimeField& field) {
+    ModPoly q, r;
+    divide(a, b, q, r, field);
+    return q;
+}
+
+ModPoly monic(ModPoly a, const PrimeField& field) {
+    if (!a.empty() && a.back() != 1) {
+        const uint64_t inv = field.inv(a.back());
+        for (auto& c : a) {
+            c = field.mul(c, inv);
+        }
+    }
+    return a;
+}
+
+ModPoly gcd(ModPoly a, ModPoly b, const PrimeField& field) {
+    while (!b.empty()) {
+        ModPoly r = remainder(a, b, field);
+        a = std::move(b);
+        b = std::move(r);
+    }
+    return monic(std::move(a), field);
+}
+
+// 扩展欧几里得：求 s、t 使 s g + t h = 1（g、h 互素），deg s < deg h，deg t < deg g
+void bezout(const ModPoly& g, const ModPoly& h, ModPoly& s, ModPoly& t, const PrimeField& field) {
+    ModPoly r0 = g, r1 = h;
+    ModPoly s0 = {1}, s1, t0, t1 = {1};
+    while (!r1.empty()) {
+        ModPoly q, r;
+        divide(r0, r1, q, r, field);
+        r0 = std::move(r1);
+        r1 = std::move(r);
+        ModPoly s2 = subtract(s0, multiply(q, s1, field), field);
+        ModPoly t2 = subtract(t0, multiply(q, t1, field), field);
+        s0 = std::move(s1);
+        s1 = std::move(s2);
+        t0 = std::move(t1);
+        t1 = std::move(t2);
+    }
+    // r0 为非零常数
+    const uint64_t inv = field.inv(r0[0]);
+    s = multiply(s0, {inv}, field);
+    t = multiply(t0, {inv}, field);
+}
+
+ModPoly derivative(const ModPoly& a, const PrimeField& field) {
+    ModPoly result(a.empty() ? 0 : a.size() - 1);
+    for (size_t k = 1; k < a.size(); ++k) {
+        result[k - 1] = field.mul(a[k], k % field.modulus());
+    }
+    trim(result);
+    return result;
+}
+
+// base^exp mod m
+ModPoly powMod(ModPoly base, const BigInt& exp, const ModPoly& m, const PrimeField& field) {
+    ModPoly result = {1};
+    base = remainder(base, m, field);
+    if (exp == 0) {
+        return remainder(result, m, field);
+    }
+    for (size_t bit = boost::multiprecision::msb(exp) + 1; bit-- > 0;) {
+        result = remainder(multiply(result, result, field), m, field);
+        if (boost::multiprecision::bit_test(exp, static_cast<unsigned>(bit))) {
+            result = remainder(multiply(result, base, field), m, field);
+        }
+    }
+    return result;
+}
+
+// 逐次次数分解：f 首一无平方，返回 (g_d, d)，g_d 为 f 中全部 d 次不可约因子之积
+std::vector<std::pair<ModPoly, size_t>> distinctDegree(ModPoly f, const PrimeField& field) {
+    std::vector<std::pair<ModPoly, size_t>> result;
+    const ModPoly x = {0, 1};
+    ModPoly h = x;
+    for (size_t d = 1; 2 * static_cast<int>(d) <= degree(f); ++d) {
+        Cancellation::checkpoint();
+        h = powMod(h, BigInt(field.modulus()), f, field); // h = x^{p^d} mod f
+        ModPoly g = gcd(f, subtract(h, x, field), field);
+        if (degree(g) > 0) {
+            result.emplace_back(g, d);
+            f = quotient(f, g, field);
+            h = remainder(h, f, field);
+        }
+    }
+    if (degree(f) > 0) {
+        result.emplace_back(f, static_cast<size_t>(degree(f)));
+    }
+    return result;
+}
+
+// Cantor-Zassenhaus 等次数分解：g 首一，是若干 d 次不可约因子之积（p 为奇素数）
+void equalDegree(const ModPoly& g, size_t d, const PrimeField& field, std::mt19937_64& rng, std::vector<ModPoly>& out) {
+    if (static_cast<size_t>(degree(g)) == d) {
+        out.push_back(g);
+        return;
+    }
+    const uint64_t p = field.modulus();
+    BigInt exp = 1;
+    for (size_t i = 0; i < d; ++i) {
+        exp *= p;
+    }
+    exp = (exp - 1) / 2;
+    while (true) {
+        Cancellation::checkpoint();
+        ModPoly a(g.size() - 1);
+        for (auto& c : a) {
+            c = rng() % p;
+        }
+        trim(a);
+        if (degree(a) < 1) {
+            continue;
+        }
+        // 对随机 a，a^{(p^d-1)/2} - 1 约有一半的概率恰好整除 g 的一部分不可约因子
+        ModPoly u = gcd(g, subtract(powMod(a, exp, g, field), {1}, field), field);
+        if (degree(u) > 0 && degree(u) < degree(g)) {
+            equalDegree(u, d, field, rng, out);
+            equalDegree(quotient(g, u, field), d, field, rng, out);
+            return;
+        }
+    }
+}
+
+std::vector<ModPoly> factorModP(const ModPoly& f, const PrimeField& field) {
+    std::mt19937_64 rng(field.modulus()); // 固定种子，结果可复现
+    std::vector<ModPoly> factors;
+    for (const auto& part : distinctDegree(f, field)) {
+        equalDegree(part.first, part.second, field, rng, factors);
+    }
+    return factors;
+}
+
+// ---------- Z 上的多项式运算 ----------
+
+IntPoly multiply(const IntPoly& a, const IntPoly& b) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+    IntPoly result(a.size() + b.size() - 1, BigInt(0));
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] == 0) {
+            continue;
+        }
+        for (size_t j = 0; j < b.size(); ++j) {
+            if (b[j] != 0) {
+                result[i + j] += a[i] * b[j];
+            }
+        }
+    }
+    return result;
+}
+
+// 非负剩余
+BigInt mod(const BigInt& x, const BigInt& m) {
+    BigInt r = x % m;
+    if (r < 0) {
+        r += m;
+    }
+    return r;
+}
+
+BigInt inverseMod(const BigInt& a, const BigInt& m) {
+    BigInt r0 = m, r1 = mod(a, m);
+    BigInt t0 = 0, t1 = 1;
+    while (r1 != 0) {
+        BigInt q = r0 / r1;
+        r0 -= q * r1;
+        r0.swap(r1);
+        t0 -= q * t1;
+        t0.swap(t1);
+    }
+    if (r0 != 1) {
+        throw std::runtime_error("Leading coefficient is not invertible modulo p^k.");
+    }
+    return mod(t0, m);
+}
+
+ModPoly reduce(const IntPoly& a, const PrimeField& field) {
+    ModPoly result(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        result[i] = field.reduce(a[i]);
+    }
+    trim(result);
+    return result;
+}
+
+IntPoly lift(const ModPoly& a) {
+    return IntPoly(a.begin(), a.end());
+}
+
+// 除去系数的最大公因数，并使首项系数为正
+IntPoly primitivePart(IntPoly a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+    BigInt g = 0;
+    for (const auto& c : a) {
+        if (c != 0) {
+            g = boost::multiprecision::gcd(g, c);
+        }
+    }
+    if (!a.empty() && a.back() < 0) {
+        g = -g;
+    }
+    if (g != 0 && g != 1) {
+        for (auto& c : a) {
+            c /= g;
+        }
+    }
+    return a;
+}
+
+// 整系数整除：b 整除 a 时写入商并返回 true
+bool divideExact(const IntPoly& a, const IntPoly& b, IntPoly& q) {
+    if (a.size() < b.size()) {
+        return false;
+    }
+    IntPoly r = a;
+    q.assign(a.size() - b.size() + 1, BigInt(0));
+    const BigInt& lead = b.back();
+    for (size_t k = q.size(); k-- > 0;) {
+        const BigInt& top = r[k + b.size() - 1];
+        if (top % lead != 0) {
+            return false;
+        }
+        BigInt c = top / lead;
+        if (c != 0) {
+            for (size_t i = 0; i < b.size(); ++i) {
+                r[k + i] -= c * b[i];
+            }
+        }
+        q[k] = std::move(c);
+    }
+    for (const auto& c : r) {
+        if (c != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------- Hensel 提升与组合 ----------
+
+// f ≡ lc(f) * prod factors (mod p)，factors 首一、两两互素。逐个剥离因子，
+// 对每一对 (其余因子之积, 当前因子) 做线性 Hensel 提升，得到模 modulus = p^k 下首一的提升因子
+std::vector<IntPoly> henselLift(const IntPoly& f, const std::vector<ModPoly>& factors, const PrimeField& field,
+                                unsigned k, const BigInt& modulus) {
+    const uint64_t p = field.modulus();
+    std::vector<IntPoly> lifted(factors.size());
+    IntPoly current(f.size());
+    for (size_t i = 0; i < f.size(); ++i) {
+        current[i] = mod(f[i], modulus);
+    }
+
+    for (size_t idx = factors.size(); idx-- > 1;) {
+        const ModPoly& hBar = factors[idx];
+        ModPoly gBar = reduce(IntPoly{current.back()}, field);
+        for (size_t j = 0; j < idx; ++j) {
+            gBar = multiply(gBar, factors[j], field);
+        }
+        ModPoly s, t;
+        bezout(gBar, hBar, s, t, field);
+
+        // 不变式：current ≡ G H (mod p^e)，H 首一
+        IntPoly G = lift(gBar), H = lift(hBar);
+        BigInt pe = p;
+        for (unsigned e = 1; e < k; ++e) {
+            Cancellation::checkpoint();
+            Progress::report("因式分解: Hensel 提升", e + 1, k);
+            IntPoly product = multiply(G, H);
+            IntPoly error(current.size());
+            for (size_t i = 0; i < current.size(); ++i) {
+                BigInt diff = current[i] - (i < product.size() ? product[i] : BigInt(0));
+                error[i] = mod(diff, modulus) / pe; // 恰好整除
+            }
+            ModPoly eBar = reduce(error, field);
+            if (!eBar.empty()) {
+                // 解 sigma g + tau h ≡ e (mod p)，deg sigma < deg h
+                ModPoly se = multiply(s, eBar, field);
+                ModPoly q, sigma;
+                divide(se, hBar, q, sigma, field);
+                ModPoly tau = add(multiply(t, eBar, field), multiply(q, gBar, field), field);
+                if (G.size() < tau.size()) {
+                    G.resize(tau.size(), BigInt(0));
+                }
+                for (size_t i = 0; i < tau.size(); ++i) {
+                    G[i] += pe * tau[i];
+                }
+                for (size_t i = 0; i < sigma.size(); ++i) {
+                    H[i] += pe * sigma[i];
+                }
+            }
+            pe *= p;
+        }
+        lifted[idx] = H;
+        current = G;
+    }
+
+    // 剩下的一个因子除以首项系数化为首一
+    const BigInt leadInv = inverseMod(current.back(), modulus);
+    for (auto& c : current) {
+        c = mod(c * leadInv, modulus);
+    }
+    lifted[0] = current;
+    return lifted;
+}
+
+// 下一个 s 元组合（下标递增），没有时返回 false
+bool nextCombination(std::vector<size_t>& idx, size_t n) {
+    size_t s = idx.size();
+    for (size_t i = s; i-- > 0;) {
+        if (idx[i] < n - s + i) {
+            ++idx[i];
+            for (size_t j = i + 1; j < s; ++j) {
+                idx[j] = idx[j - 1] + 1;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// Zassenhaus 组合：依次尝试 1 个、2 个……提升因子之积（乘上首项系数后取对称剩余），能整除的即为真因子
+std::vector<IntPoly> recombine(IntPoly f, std::vector<IntPoly> lifted, const BigInt& modulus) {
+    std::vector<IntPoly> result;
+    const BigInt half = modulus / 2;
+    auto symmetric = [&](const BigInt& x) { return x > half ? BigInt(x - modulus) : x; };
+
+    size_t s = 1;
+    while (2 * s <= lifted.size()) {
+        Progress::report("因式分解: 组合试除", s, lifted.size() / 2);
+        std::vector<size_t> idx(s);
+        for (size_t i = 0; i < s; ++i) {
+            idx[i] = i;
+        }
+        bool found = false;
+        do {
+            Cancellation::checkpoint();
+            const BigInt& lead = f.back();
+            // 先只比较常数项：候选因子的常数项必须整除 lc(f) * f(0)
+            if (f[0] != 0) {
+                BigInt c0 = mod(lead, modulus);
+                for (size_t i : idx) {
+                    c0 = mod(c0 * lifted[i][0], modulus);
+                }
+                c0 = symmetric(c0);
+                if (c0 == 0 || (lead * f[0]) % c0 != 0) {
+                    continue;
+                }
+            }
+            IntPoly g = {mod(lead, modulus)};
+            for (size_t i : idx) {
+                g = multiply(g, lifted[i]);
+                for (auto& c : g) {
+                    c = mod(c, modulus);
+                }
+            }
+            for (auto& c : g) {
+                c = symmetric(c);
+            }
+            g = primitivePart(g);
+            IntPoly q;
+            if (divideExact(f, g, q)) {
+                result.push_back(g);
+                f = primitivePart(q);
+                for (size_t i = s; i-- > 0;) {
+                    lifted.erase(lifted.begin() + static_cast<std::ptrdiff_t>(idx[i]));
+                }
+                found = true;
+                break;
+            }
+        } while (nextCombination(idx, lifted.size()));
+        if (!found) {
+            ++s;
+        }
+    }
+    if (f.size() > 1) {
+        result.push_back(primitivePart(f));
+    }
+    return result;
+}
+
+// p = primitive * 返回值，primitive 为首项系数为正的本原整系数多项式
+Fraction toPrimitive(const DensePolynomial& p, IntPoly& primitive) {
+    BigInt den = 1;
+    for (const auto& c : p.coefficients()) {
+        const BigInt& d = c.getDenominator();
+        if (d != 1 && den % d != 0) {
+            den = den / boost::multiprecision::gcd(den, d) * d;
+        }
+    }
+    IntPoly ints(p.coefficients().size());
+    for (size_t i = 0; i < ints.size(); ++i) {
+        const Fraction& c = p.coefficients()[i];
+        ints[i] = c.getNumerator() * (den / c.getDenominator());
+    }
+    primitive = primitivePart(ints);
+    return Fraction(ints.back(), den) / Fraction(primitive.back());
+}
+
+DensePolynomial toDense(const IntPoly& a) {
+    std::vector<Fraction> coeffs(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        coeffs[i] = Fraction(a[i]);
+    }
+    return DensePolynomial(std::move(coeffs));
+}
+
+} // namespace
+
+std::vector<PolynomialFactoring::Factor> PolynomialFactoring::squareFreeDecomposition(const DensePolynomial& f) {
+    std::vector<Factor> result;
+    if (f.degree() < 1) {
+        return result;
+    }
+    // b_1 = f / gcd(f, f')，d_1 = f' / gcd(f, f') - b_1'；a_i = gcd(b_i, d_i)，
+    // b_{i+1} = b_i / a_i，d_{i+1} = d_i / a_i - b_{i+1}'
+    DensePolynomial df = f.derivative();
+    DensePolynomial a0 = DensePolynomial::gcd(f, df);
+    DensePolynomial b, c, rem;
+    f.divide(a0, b, rem);
+    df.divide(a0, c, rem);
+    DensePolynomial d = c - b.derivative();
+    for (unsigned i = 1; b.degree() > 0; ++i) {
+        Cancellation::checkpoint();
+        DensePolynomial a = DensePolynomial::gcd(b, d);
+        if (a.degree() > 0) {
+            result.push_back({a, i});
+        }
+        DensePolynomial nextB;
+        b.divide(a, nextB, rem);
+        d.divide(a, c, rem);
+        b = nextB;
+        d = c - b.derivative();
+    }
+    return result;
+}
+
+std::vector<std::vector<BigInt>> PolynomialFactoring::factorSquareFree(const std::vector<BigInt>& f) {
+    const int n = static_cast<int>(f.size()) - 1;
+    if (n < 1) {
+        throw std::invalid_argument("factorSquareFree expects a non-constant polynomial.");
+    }
+    if (n == 1) {
+        return {primitivePart(f)};
+    }
+
+    // 选素数：p 不整除首项系数，且 f 模 p 仍无平方；在若干个这样的素数中取因子最少的
+    uint64_t bestPrime = 0;
+    std::vector<ModPoly> bestFactors;
+    size_t good = 0;
+    for (uint64_t p = 3; good < CANDIDATE_PRIMES; p += 2) {
+        if (!ModularOperations::isPrime(p) || f.back() % p == 0) {
+            continue;
+        }
+        PrimeField field(p);
+        ModPoly fBar = reduce(f, field);
+        if (degree(gcd(fBar, derivative(fBar, field), field)) > 0) {
+            continue;
+        }
+        std::vector<ModPoly> factors = factorModP(monic(fBar, field), field);
+        ++good;
+        if (bestPrime == 0 || factors.size() < bestFactors.size()) {
+            bestPrime = p;
+            bestFactors = std::move(factors);
+        }
+        if (bestFactors.size() == 1) {
+            return {primitivePart(f)}; // 模 p 不可约，则在 Z 上也不可约
+        }
+    }
+
+    // Mignotte 界：f 的因子（乘上 lc(f) 后）系数不超过 |lc(f)| * 2^n * ||f||_2，模数须超过其 2 倍
+    BigInt normSquared = 0;
+    for (const auto& c : f) {
+        normSquared += c * c;
+    }
+    BigInt bound = (boost::multiprecision::sqrt(normSquared) + 1) * abs(f.back()) * (BigInt(1) << n);
+    unsigned k = 1;
+    BigInt modulus = bestPrime;
+    while (modulus <= bound * 2) {
+        modulus *= bestPrime;
+        ++k;
+    }
+
+    PrimeField field(bestPrime);
+    std::vector<IntPoly> lifted = henselLift(f, bestFactors, field, k, modulus);
+    return recombine(f, std::move(lifted), modulus);
+}
+
+std::vector<PolynomialFactoring::Factor> PolynomialFactoring::factor(const DensePolynomial& f, Fraction& content) {
+    if (f.isZero()) {
+        throw std::invalid_argument("Cannot factor the zero polynomial.");
+    }
+    std::vector<Factor> result;
+    content = f.coefficients().back();
+    if (f.degree() == 0) {
+        return result;
+    }
+
+    // x 的幂单独提出
+    size_t zeros = 0;
+    while (f.coefficients()[zeros].getNumerator() == 0) {
+        ++zeros;
+    }
+    if (zeros > 0) {
+        result.push_back({DensePolynomial(std::vector<Fraction>{Fraction(0), Fraction(1)}), static_cast<unsigned>(zeros)});
+    }
+    DensePolynomial rest(std::vector<Fraction>(f.coefficients().begin() + static_cast<std::ptrdiff_t>(zeros), f.coefficients().end()));
+
+    for (const auto& part : squareFreeDecomposition(rest)) {
+        IntPoly primitive;
+        toPrimitive(part.polynomial, primitive);
+        for (const auto& g : factorSquareFree(primitive)) {
+            result.push_back({toDense(g), part.multiplicity});
+        }
+    }
+
+    // 各因子首项系数为正且本原，由 Gauss 引理，content = lc(f) / prod lc(g_j)^{m_j}
+    for (const auto& factor : result) {
+        const Fraction& lead = factor.polynomial.coefficients().back();
+        for (unsigned m = 0; m < factor.multiplicity; ++m) {
+            content = content / lead;
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const Factor& a, const Factor& b) {
+        return a.polynomial.degree() < b.polynomial.degree();
+    });
+    return result;
+}
+
+} // namespace Algebra
@@ -0,0 +1,39 @@
+#ifndef ALGEBRA_POLYNOMIAL_FACTORING_H
+#define ALGEBRA_POLYNOMIAL_FACTORING_H
+
+#include "dense_polynomial.h"
+#include <vector>
+
+namespace Algebra {
+
+/**
+ * @class PolynomialFactoring
+ * @brief 有理系数单变量多项式在 Q 上的完全因式分解。
+ *
+ * 先做 Yun 无平方分解，再对每个无平方部分做 Zassenhaus 分解：
+ * 选一个使其模 p 后仍无平方的小素数，在 F_p 上用逐次次数分解与 Cantor-Zassenhaus 算法分解，
+ * 再用 Hensel 提升把各因子提升到超过 Mignotte 界的模数 p^k，最后组合提升因子试除得到整系数因子。
+ * 不依赖有理根定理，因此常数项很大、含不可约二次或三次因子的多项式同样适用。
+ */
+class PolynomialFactoring {
+public:
+    struct Factor {
+        DensePolynomial polynomial;
+        unsigned multiplicity;
+    };
+
+    // Yun 无平方分解：f = lc(f) * prod a_i^i，各 a_i 首一、无平方且两两互素。
+    // 返回非常数的 a_i 及其重数 i，按重数递增
+    static std::vector<Factor> squareFreeDecomposition(const DensePolynomial& f);
+
+    // 分解为不可约因子：f = content * prod g_j^{m_j}，g_j 为首项系数为正的本原整系数多项式，
+    // 按次数递增排列。f 为零多项式时抛出 std::invalid_argument
+    static std::vector<Factor> factor(const DensePolynomial& f, Fraction& content);
+
+    // 本原、无平方、次数不低于 1 的整系数多项式（系数按升幂排列）的不可约分解，各因子首项系数为正
+    static std::vector<std::vector<BigInt>> factorSquareFree(const std::vector<BigInt>& f);
+};
+
+} // namespace Algebra
+
+#endif // ALGEBRA_POLYNOMIAL_FACTORING_H
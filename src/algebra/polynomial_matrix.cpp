@@ -1,5 +1,12 @@
 #include "polynomial_matrix.h"
 #include "equation.h"
+#include "dense_polynomial.h"
+#include "../matrix_operations.h"
+#include "../task_scheduler.h"
+#include "../cancellation.h"
+#include "../progress.h"
+#include <atomic>
+#include <memory>
 #include <stdexcept>
 #include <sstream>
 #include <algorithm>
@@ -66,49 +73,156 @@ std::string PolynomialMatrix::toString() const {
     return ss.str();
 }
 
-PolynomialMatrix PolynomialMatrix::getSubMatrix(size_t excludeRow, size_t excludeCol) const {
-    if (rows <= 1 || cols <= 1) {
-        return PolynomialMatrix(0,0);
-    }
-    PolynomialMatrix sub(rows - 1, cols - 1);
-    size_t r_sub = 0;
-    for (size_t r = 0; r < rows; ++r) {
-        if (r == excludeRow) continue;
-        size_t c_sub = 0;
-        for (size_t c = 0; c < cols; ++c) {
-            if (c == excludeCol) continue;
-            sub.at(r_sub, c_sub) = this->at(r, c);
-            c_sub++;
-        }
-        r_sub++;
+Polynomial PolynomialMatrix::determinant() const {
+    if (rows != cols) {
+        throw std::runtime_error("Determinant can only be calculated for square matrices.");
+    }
+    std::vector<DensePolynomial> entries;
+    std::string variable;
+    if (rows >= INTERPOLATION_MIN_ORDER && toDense(entries, variable)) {
+        return determinantByInterpolation(entries, rows, variable);
     }
-    return sub;
+    return determinantByExpansion();
 }
 
 // 使用代数余子式展开计算行列式
-Polynomial PolynomialMatrix::determinant() const {
+Polynomial PolynomialMatrix::determinantByExpansion() const {
+    if (rows != cols) {
+        throw std::runtime_error("Determinant can only be calculated for square matrices.");
+    }
+    if (rows == 0) {
+        return Polynomial("1"); // 约定
+    }
+    PolynomialMatrixView::Workspace ws(rows, cols);
+    return determinantOfView(PolynomialMatrixView(*this, rows, cols, ws), ws);
+}
+
+bool PolynomialMatrix::toDense(std::vector<DensePolynomial>& entries, std::string& variable) const {
+    entries.resize(rows * cols);
+    variable.clear();
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            const Polynomial& p = data[i][j];
+            DensePolynomial& dense = entries[i * cols + j];
+            if (!DensePolynomial::fromPolynomial(p, dense)) {
+                return false;
+            }
+            if (dense.degree() > 0) {
+                if (variable.empty()) {
+                    variable = p.getVariableName();
+                } else if (p.getVariableName() != variable) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+Polynomial PolynomialMatrix::determinantByInterpolation() const {
     if (rows != cols) {
         throw std::runtime_error("Determinant can only be calculated for square matrices.");
     }
     if (rows == 0) {
         return Polynomial("1"); // 约定
     }
-    if (rows == 1) {
-        return data[0][0];
+    std::vector<DensePolynomial> entries;
+    std::string variable;
+    if (!toDense(entries, variable)) {
+        throw std::invalid_argument("Interpolation requires rational polynomial entries in a single variable.");
     }
-    if (rows == 2) {
-        return (data[0][0] * data[1][1]) - (data[0][1] * data[1][0]);
+    return determinantByInterpolation(entries, rows, variable);
+}
+
+Polynomial PolynomialMatrix::determinantByInterpolation(const std::vector<DensePolynomial>& entries, size_t n,
+                                                        const std::string& variable) {
+
+    // 次数界取按行、按列两种估计中较小的一个
+    size_t rowBound = 0, colBound = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int rowMax = 0, colMax = 0;
+        for (size_t j = 0; j < n; ++j) {
+            rowMax = std::max(rowMax, entries[i * n + j].degree());
+            colMax = std::max(colMax, entries[j * n + i].degree());
+        }
+        rowBound += static_cast<size_t>(rowMax);
+        colBound += static_cast<size_t>(colMax);
     }
+    const size_t bound = std::min(rowBound, colBound);
+
+    // 插值点取以 0 为中心的连续整数，使求值后的矩阵元素尽量小
+    const long long offset = static_cast<long long>(bound / 2);
+    std::vector<Fraction> values(bound + 1);
+    std::atomic<size_t> finished{0};
+    TaskScheduler::parallelFor(0, bound + 1, [&](size_t k) {
+        Cancellation::checkpoint();
+        const Fraction x(static_cast<long long>(k) - offset);
+        Matrix point(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                point.at(i, j) = entries[i * n + j].evaluate(x);
+            }
+        }
+        values[k] = MatrixOperations::determinant(point);
+        Progress::report("多项式矩阵行列式: 已求值点", finished.fetch_add(1) + 1, bound + 1);
+    });
+
+    // 牛顿差商：相邻插值点相差 1，第 j 层的分母恰为 j
+    for (size_t j = 1; j <= bound; ++j) {
+        const Fraction step(static_cast<long long>(j));
+        for (size_t k = bound; k >= j; --k) {
+            values[k] = (values[k] - values[k - 1]) / step;
+        }
+    }
+    // 由牛顿形式展开：p = c_D，再依次 p = p * (x - x_k) + c_k
+    DensePolynomial result(std::vector<Fraction>{values[bound]});
+    for (size_t k = bound; k-- > 0;) {
+        const Fraction root(static_cast<long long>(k) - offset);
+        result = result * DensePolynomial(std::vector<Fraction>{Fraction(0) - root, Fraction(1)})
+               + DensePolynomial(std::vector<Fraction>{values[k]});
+    }
+    return result.toPolynomial(variable);
+}
+
+Polynomial PolynomialMatrix::determinantOfView(const PolynomialMatrixView& view, PolynomialMatrixView::Workspace& ws) {
+    size_t n = view.rowCount();
+    if (n == 1) {
+        return view.at(0, 0);
+    }
+    if (n == 2) {
+        return (view.at(0, 0) * view.at(1, 1)) - (view.at(0, 1) * view.at(1, 0));
+    }
+
+    Cancellation::checkpoint();
+    Progress::advance("多项式矩阵行列式: 已展开子式");
 
     Polynomial det_poly; // 初始化为 0
-    Polynomial sign_poly(Monomial(Fraction(1))); // 符号从 +1 开始
+
+    // 阶数较高时各子式交给线程池并行展开（子任务还会继续分叉）；
+    // 每个子任务使用自己的工作区，最后按列的顺序合并，结果与串行相同
+    if (n >= PARALLEL_MIN_ORDER && TaskScheduler::threadCount() > 1) {
+        std::vector<Polynomial> sub_dets(n);
+        TaskGroup group;
+        for (size_t j = 0; j < n; ++j) {
+            auto child_ws = std::make_shared<PolynomialMatrixView::Workspace>(n - 1, n - 1);
+            PolynomialMatrixView child = view.minor(0, j, ws).detach(*child_ws);
+            group.run([child, child_ws, &sub_dets, j] {
+                sub_dets[j] = determinantOfView(child, *child_ws);
+            });
+        }
+        group.wait();
+        for (size_t j = 0; j < n; ++j) {
+            Polynomial term = view.at(0, j) * sub_dets[j];
+            det_poly = (j % 2 == 0) ? det_poly + term : det_poly - term;
+        }
+        return det_poly;
+    }
 
     // 沿第一行展开
-    for (size_t j = 0; j < cols; ++j) {
-        Polynomial sub_det = getSubMatrix(0, j).determinant();
-        Polynomial term = data[0][j] * sub_det;
-        det_poly = det_poly + (sign_poly * term);
-        sign_poly = sign_poly * Polynomial(Monomial(Fraction(-1))); // 翻转符号
+    for (size_t j = 0; j < n; ++j) {
+        Polynomial sub_det = determinantOfView(view.minor(0, j, ws), ws);
+        Polynomial term = view.at(0, j) * sub_det;
+        det_poly = (j % 2 == 0) ? det_poly + term : det_poly - term;
     }
 
     return det_poly;
@@ -123,12 +237,14 @@ std::string calculate_eigenvalues(const Matrix& m) {
         return "Eigenvalues: (none for empty matrix)";
     }
 
-    // 1. 创建特征矩阵 A - x*I
+    // 1. 计算特征多项式 det(A - x*I) = (-1)^n det(xI - A)。
+    //    系数由 Berkowitz 算法在有理数上直接算出，不再对特征矩阵 A - x*I 做多项式的代数余子式展开
     std::string var_name = "x";
-    PolynomialMatrix char_matrix(m, var_name);
+    std::vector<Fraction> coefficients = MatrixOperations::characteristicPolynomial(m);
+    Fraction sign(m.rowCount() % 2 == 0 ? 1 : -1);
 
-    // 2. 计算特征多项式 det(A - x*I)
-    Polynomial char_poly = char_matrix.determinant();
+    // 2. 由稠密系数转换为 Polynomial，输出格式与原来相同
+    Polynomial char_poly = (DensePolynomial(coefficients) * sign).toPolynomial(var_name);
     std::string char_eq_str = char_poly.toString() + " = 0";
 
     // 3. 求解特征方程
@@ -2,12 +2,17 @@
 #define ALGEBRA_POLYNOMIAL_MATRIX_H
 
 #include "polynomial.h"
+#include "dense_polynomial.h"
 #include "../matrix.h" // 用于转换
+#include "../matrix_view.h"
 #include <vector>
 #include <string>
 
 namespace Algebra {
 
+class PolynomialMatrix;
+using PolynomialMatrixView = BasicMatrixView<PolynomialMatrix>;
+
 class PolynomialMatrix {
 private:
     std::vector<std::vector<Polynomial>> data;
@@ -26,12 +31,33 @@ public:
 
     std::string toString() const;
 
-    // 计算行列式，返回一个多项式
+    // 计算行列式，返回一个多项式。
+    // 阶数不低于 INTERPOLATION_MIN_ORDER 且各元素都能转换为同一变量的稠密多项式时用求值/插值，否则按代数余子式展开
     Polynomial determinant() const;
 
+    // 新增：沿第一行做符号代数余子式展开，运算量随阶数阶乘增长
+    Polynomial determinantByExpansion() const;
+
+    // 新增：求值/插值。det 的次数不超过各行最高次数之和 D（也不超过各列之和），
+    // 在 D+1 个整数点处求值得到有理数矩阵，用精确消元引擎并行求各点的行列式，再做牛顿插值还原。
+    // 各元素须是同一变量的有理系数、非负整数次幂多项式，否则抛出 std::invalid_argument
+    Polynomial determinantByInterpolation() const;
+
 private:
-    // 行列式计算的辅助函数
-    PolynomialMatrix getSubMatrix(size_t excludeRow, size_t excludeCol) const;
+    // 新增：不低于该阶的子式把各展开项交给线程池并行计算
+    static const size_t PARALLEL_MIN_ORDER = 6;
+    // 新增：determinant() 从该阶起优先使用求值/插值
+    static const size_t INTERPOLATION_MIN_ORDER = 4;
+
+    // 把全部元素转换为稠密形式，variable 为非常数元素共同的变量名；不能转换时返回 false
+    bool toDense(std::vector<DensePolynomial>& entries, std::string& variable) const;
+
+    // 求值/插值的主体：entries 为 toDense 转换好的 n x n 元素（按行存放），determinant() 借此避免重复转换
+    static Polynomial determinantByInterpolation(const std::vector<DensePolynomial>& entries, size_t n,
+                                                 const std::string& variable);
+
+    // 行列式计算的辅助函数：在子式视图上递归展开，不复制子矩阵
+    static Polynomial determinantOfView(const PolynomialMatrixView& view, PolynomialMatrixView::Workspace& ws);
 };
 
 // 新增：计算特征值的函数
@@ -1,6 +1,11 @@
 #include "polynomial.h"
 #include "../fraction.h"
 #include "radical.h"
+#include "dense_polynomial.h"
+#include "polynomial_factoring.h"
+#include "../integer_factorization.h"
+#include "../cancellation.h"
+#include "../progress.h"
 #include <stdexcept>
 #include <sstream>
 #include <algorithm>
@@ -16,6 +21,13 @@ namespace Algebra
         if (terms.empty())
             return Fraction(0);
 
+        // 新增：能转换为稠密形式时用秦九韶法求值，不必逐项求幂
+        DensePolynomial dense;
+        if (DensePolynomial::fromPolynomial(*this, dense))
+        {
+            return dense.evaluate(x);
+        }
+
         Fraction result(0);
         for (const auto &term : terms)
         {
@@ -117,18 +129,11 @@ namespace Algebra
         if (num == 0)
             return {Fraction(0)};
 
-        for (BigInt i = 1; i * i <= num; ++i)
+        // 由素因子分解枚举全部因数，避免试除到 sqrt(num)
+        for (const BigInt &d : IntegerFactorization::divisors(num))
         {
-            if (num % i == 0)
-            {
-                factors.push_back(Fraction(i));
-                factors.push_back(Fraction(-i));
-                if (i != num / i)
-                {
-                    factors.push_back(Fraction(num / i));
-                    factors.push_back(Fraction(-(num / i)));
-                }
-            }
+            factors.push_back(Fraction(d));
+            factors.push_back(Fraction(-d));
         }
 
         return factors;
@@ -177,28 +182,18 @@ namespace Algebra
         std::vector<Fraction> possible_roots;
         for (const auto &p : p_factors)
         {
+            Cancellation::checkpoint();
             for (const auto &q : q_factors)
             {
                 if (q.getNumerator() != 0)
                 {
-                    Fraction root = p / q;
-                    // 避免重复
-                    bool found = false;
-                    for (const auto &existing : possible_roots)
-                    {
-                        if (root == existing)
-                        {
-                            found = true;
-                            break;
-                        }
-                    }
-                    if (!found)
-                    {
-                        possible_roots.push_back(root);
-                    }
+                    possible_roots.push_back(p / q);
                 }
             }
         }
+        // 排序后去重，代替逐个比较的 O(k^2) 查找
+        std::sort(possible_roots.begin(), possible_roots.end());
+        possible_roots.erase(std::unique(possible_roots.begin(), possible_roots.end()), possible_roots.end());
 
         // 对可能的根进行排序，优先测试小的整数根
         std::sort(possible_roots.begin(), possible_roots.end(), [](const Fraction &a, const Fraction &b)
@@ -270,6 +265,12 @@ namespace Algebra
                             roots.push_back(root.toString());
                             roots.push_back(root.toString()); // 二次重根，添加两次
                         }
+                        else if (discriminant < Fraction(0))
+                        {
+                            // 新增：不可约二次因子的判别式为负时只有复根，其余因子的实根照常给出
+                            roots.push_back("CANT_SOLVE");
+                            roots.push_back("CANT_SOLVE");
+                        }
                         else if (is_perfect_square(discriminant))
                         {
                             // 有理根
@@ -355,7 +356,76 @@ namespace Algebra
             current = basic_factors.back();
         }
 
-        // 对剩余的多项式使用有理根定理
+        // 新增：能转换为稠密形式时交给因式分解引擎（Yun 无平方分解 + 模素数分解 + Hensel 提升），
+        // 一次得到全部不可约因子，不再逐个试探有理根
+        DensePolynomial dense;
+        if (current.getDegree() > Fraction(2) && DensePolynomial::fromPolynomial(current, dense))
+        {
+            Fraction content;
+            auto irreducible = PolynomialFactoring::factor(dense, content);
+            // perform_factorization 得到的剩余部分不带变量名，取原多项式的
+            const std::string &var = variable_name.empty() ? current.variable_name : variable_name;
+
+            // 一次因子 a x + b 写成首一的 (x - r)，首项系数并入常数因子
+            std::vector<std::pair<Fraction, unsigned>> linear_roots;
+            std::vector<Polynomial> higher;
+            for (const auto &f : irreducible)
+            {
+                const std::vector<Fraction> &c = f.polynomial.coefficients();
+                if (f.polynomial.degree() == 1)
+                {
+                    linear_roots.emplace_back(Fraction(0) - c[0] / c[1], f.multiplicity);
+                    for (unsigned m = 0; m < f.multiplicity; ++m)
+                    {
+                        content = content * c[1];
+                    }
+                }
+                else
+                {
+                    for (unsigned m = 0; m < f.multiplicity; ++m)
+                    {
+                        higher.push_back(f.polynomial.toPolynomial(var));
+                    }
+                }
+            }
+            // 与原来有理根的试探顺序一致：整数根在前，再按绝对值从小到大
+            std::stable_sort(linear_roots.begin(), linear_roots.end(), [](const auto &a, const auto &b)
+                             {
+                bool a_is_int = (a.first.getDenominator() == 1);
+                bool b_is_int = (b.first.getDenominator() == 1);
+                if (a_is_int != b_is_int) return a_is_int;
+                if (abs(a.first.getNumerator()) != abs(b.first.getNumerator()))
+                    return abs(a.first.getNumerator()) < abs(b.first.getNumerator());
+                return a.first < b.first; });
+
+            if (content != Fraction(1))
+            {
+                Polynomial constant_factor;
+                constant_factor.terms.emplace_back(SimplifiedRadical(content), "", Fraction(0));
+                factors.push_back(constant_factor);
+            }
+            for (const auto &root : linear_roots)
+            {
+                for (unsigned m = 0; m < root.second; ++m)
+                {
+                    Polynomial linear_factor;
+                    linear_factor.variable_name = var;
+                    linear_factor.terms.emplace_back(SimplifiedRadical(Fraction(1)), var, Fraction(1));
+                    if (root.first.getNumerator() != 0)
+                    {
+                        linear_factor.terms.emplace_back(SimplifiedRadical(Fraction(0) - root.first), "", Fraction(0));
+                    }
+                    factors.push_back(linear_factor);
+                }
+            }
+            for (const auto &f : higher)
+            {
+                factors.push_back(f);
+            }
+            return factors;
+        }
+
+        // 含分数次幂或过于稀疏的多项式仍使用有理根定理
         int max_iterations = 20; // 防止无限循环
         int iteration_count = 0;
 
@@ -366,8 +436,11 @@ namespace Algebra
 
             // 添加调试信息
             std::vector<Fraction> actual_roots;
+            size_t candidates_tried = 0;
             for (const auto &root : possible_roots)
             {
+                Cancellation::checkpoint();
+                Progress::report("有理根: 检验候选", ++candidates_tried, possible_roots.size());
                 try
                 {
                     Fraction eval_result = current.evaluate(root);
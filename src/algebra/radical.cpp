@@ -1,4 +1,5 @@
 #include "radical.h"
+#include "../integer_factorization.h"
 #include <sstream>
 #include <stdexcept>
 
@@ -13,23 +14,15 @@ static std::pair<BigInt, BigInt> simplify_integer_nth_root(BigInt n, long long d
     if (n == 0) return {0, 1};
     if (degree <= 0) throw std::runtime_error("根式的阶数必须为正数");
     
+    // 按素因子分解逐个提出 degree 次方；分解失败留下的合数按一个整体处理，
+    // 它已确认不是完全方幂，最多少提出其中的部分方幂因子，结果仍然正确
     BigInt k = 1;
-    BigInt m = abs(n);
-    
-    // 检查因子 2
-    BigInt two_power = static_cast<BigInt>(1) << degree; // 2^degree
-    while (m % two_power == 0) {
-        m /= two_power;
-        k *= 2;
-    }
-
-    // 检查奇数因子
-    for (BigInt i = 3; boost::multiprecision::pow(i, degree) <= m; i += 2) {
-        BigInt i_power = boost::multiprecision::pow(i, degree);
-        while (m % i_power == 0) {
-            m /= i_power;
-            k *= i;
-        }
+    BigInt m = 1;
+    for (const auto& pe : IntegerFactorization::factor(n)) {
+        const unsigned long long outside = pe.second / static_cast<unsigned long long>(degree);
+        const unsigned long long inside = pe.second % static_cast<unsigned long long>(degree);
+        k *= boost::multiprecision::pow(pe.first, static_cast<unsigned>(outside));
+        m *= boost::multiprecision::pow(pe.first, static_cast<unsigned>(inside));
     }
     
     // 如果原数是负数且是奇次根，保持符号
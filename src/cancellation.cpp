@@ -0,0 +1,26 @@
+#include "cancellation.h"
+
+std::atomic<bool> Cancellation::flag{false};
+std::atomic<int> Cancellation::active{0};
+
+void Cancellation::request() {
+    flag.store(true);
+}
+
+bool Cancellation::requested() {
+    return flag.load();
+}
+
+bool Cancellation::running() {
+    return active.load() > 0;
+}
+
+Cancellation::Scope::Scope() {
+    if (active.fetch_add(1) == 0) {
+        flag.store(false);
+    }
+}
+
+Cancellation::Scope::~Scope() {
+    active.fetch_sub(1);
+}
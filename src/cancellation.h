@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+
+// 计算被取消时由 Cancellation::checkpoint() 抛出。
+// 故意不继承 std::exception：各处 catch (const std::exception&) 的回退逻辑不会把取消当作普通错误吞掉，
+// 取消会一直传到发起计算的地方
+class OperationCancelled {
+public:
+    const char* what() const noexcept { return "计算已取消"; }
+};
+
+// 协作式取消：耗时的内核（消元的每个主元步骤、余子式展开、多项式矩阵行列式、有理根搜索等）
+// 以较粗的粒度调用 checkpoint()，取消请求发出后在下一个检查点抛出 OperationCancelled。
+// request() 只写一个无锁原子变量，可以在信号处理函数（Ctrl-C）或其他线程中调用
+class Cancellation {
+public:
+    static void request();
+    static bool requested();
+
+    // 已请求取消时抛出 OperationCancelled
+    static void checkpoint() {
+        if (flag.load(std::memory_order_relaxed)) {
+            throw OperationCancelled();
+        }
+    }
+
+    // 当前是否有可取消的计算在进行（Ctrl-C 据此决定是取消计算还是退出程序）
+    static bool running();
+
+    // 一次可取消的计算：构造时清除上一次遗留的取消请求并标记计算开始，析构时标记结束
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    static std::atomic<bool> flag;
+    static std::atomic<int> active;
+};
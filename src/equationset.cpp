@@ -1,9 +1,12 @@
 #include "equationset.h"
 #include "matrix_operations.h"
+#include "modular_arithmetic.h"
 #include <sstream>
 #include <iomanip>
 #include <vector> // 新增
 #include <stdexcept> // 新增
+#include <algorithm>
+#include <boost/multiprecision/integer.hpp>
 
 // EquationSolution 实现
 EquationSolution::EquationSolution() : type(SolutionType::UNDETERMINED),
@@ -230,8 +233,14 @@ EquationSolution EquationSolution::deserialize(const std::string& s) {
 
 // 新增：实现 solve(Matrix, Vector)
 EquationSolution EquationSolver::solve(const Matrix& A, const Vector& b) {
-    OperationHistory dummy;
-    return solve(A, b, dummy);
+    if (A.rowCount() != b.size() && b.size() != 0) {
+        throw std::invalid_argument("系数矩阵的行数必须与向量 b 的元素个数匹配");
+    }
+    Matrix b_matrix(b.size(), 1);
+    for (size_t i = 0; i < b.size(); ++i) {
+        b_matrix.at(i, 0) = b.at(i);
+    }
+    return solve(A, b_matrix);
 }
 
 // 新增：实现 solve(Matrix, Vector, OperationHistory)
@@ -249,10 +258,65 @@ EquationSolution EquationSolver::solve(const Matrix& A, const Vector& b, Operati
 }
 
 EquationSolution EquationSolver::solve(const Matrix& A, const Matrix& b) {
-    OperationHistory dummy;
+    // 新增：非奇异方阵优先用 Dixon p-adic 提升求唯一解。模 p 逆矩阵存在即证明了 A 可逆，
+    // 因此不必再做有理数消元求秩；失败（A 奇异）时回退到最简行阶梯形求解
+    if (A.rowCount() == A.colCount() && A.rowCount() > 0 &&
+        b.rowCount() == A.rowCount() && b.colCount() == 1) {
+        Matrix x(A.colCount(), 1);
+        if (solveNonsingularSystem(A, b, x)) {
+            EquationSystemInfo info;
+            info.numEquations = A.rowCount();
+            info.numVariables = A.colCount();
+            info.coefficientRank = info.numVariables;
+            info.augmentedRank = info.numVariables;
+            classifySystem(info);
+
+            EquationSolution solution;
+            solution.setSystemInfo(info);
+            solution.setInitialAugmentedMatrix(A.augment(b));
+            solution.setSolutionType(info.solutionType);
+            solution.setParticularSolution(x);
+            solution.setDetailedDescription(generateSolutionDescription(solution));
+            return solution;
+        }
+    }
+
+    NullOperationHistory dummy;
     return solve(A, b, dummy);
 }
 
+EquationSolution EquationSolver::solve(const Factorization& factors, const Matrix& b) {
+    if (factors.rowCount() != b.rowCount()) {
+        throw std::invalid_argument("系数矩阵和常数向量的行数不匹配");
+    }
+    if (b.colCount() != 1) {
+        throw std::invalid_argument("常数项必须是列向量(nx1矩阵)");
+    }
+
+    Matrix x(factors.colCount(), 1);
+    bool consistent = factors.solve(b, x);
+
+    EquationSystemInfo info;
+    info.numEquations = factors.rowCount();
+    info.numVariables = factors.colCount();
+    info.coefficientRank = factors.rank();
+    info.augmentedRank = consistent ? info.coefficientRank : info.coefficientRank + 1;
+    classifySystem(info);
+
+    EquationSolution solution;
+    solution.setSystemInfo(info);
+    solution.setInitialAugmentedMatrix(factors.matrix().augment(b));
+    solution.setSolutionType(info.solutionType);
+    if (consistent) {
+        solution.setParticularSolution(x);
+        if (info.solutionType == SolutionType::INFINITE_SOLUTIONS) {
+            solution.setHomogeneousSolutions(factors.nullspace());
+        }
+    }
+    solution.setDetailedDescription(generateSolutionDescription(solution));
+    return solution;
+}
+
 EquationSolution EquationSolver::solve(const Matrix& A, const Matrix& b, OperationHistory& history) {
     EquationSolution solution;
     
@@ -269,21 +333,25 @@ EquationSolution EquationSolver::solve(const Matrix& A, const Matrix& b, Operati
     EquationSystemInfo info = analyzeSystem(A, b);
     solution.setSystemInfo(info);
     
-    history.addStep(OperationStep(
-        OperationType::INITIAL_STATE,
-        "开始求解线性方程组 Ax = b",
-        A
-    ));
+    if (history.isRecording()) {
+        history.addStep(
+            OperationType::INITIAL_STATE,
+            "开始求解线性方程组 Ax = b",
+            A
+        );
+    }
     
     // 创建增广矩阵 [A|b]
     Matrix augmented = A.augment(b);
     solution.setInitialAugmentedMatrix(augmented); // 设置初始增广矩阵
     
-    history.addStep(OperationStep(
-        OperationType::RESULT_STATE,
-        "构造增广矩阵 [A|b]:",
-        augmented
-    ));
+    if (history.isRecording()) {
+        history.addStep(
+            OperationType::RESULT_STATE,
+            "构造增广矩阵 [A|b]:",
+            augmented
+        );
+    }
     
     // 化为最简行阶梯形
     MatrixOperations::toReducedRowEchelonForm(augmented, history);
@@ -305,22 +373,26 @@ EquationSolution EquationSolver::solve(const Matrix& A, const Matrix& b, Operati
     
     switch (info.solutionType) {
         case SolutionType::NO_SOLUTION:
-            history.addStep(OperationStep(
-                OperationType::RESULT_STATE,
-                "方程组无解: rank(A) < rank([A|b])",
-                augmented
-            ));
+            if (history.isRecording()) {
+                history.addStep(
+                    OperationType::RESULT_STATE,
+                    "方程组无解: rank(A) < rank([A|b])",
+                    augmented
+                );
+            }
             break;
             
         case SolutionType::UNIQUE_SOLUTION: {
             Matrix x = findParticularSolution(A_rref, b_rref, pivotCols);
             solution.setParticularSolution(x);
             
-            history.addStep(OperationStep(
-                OperationType::RESULT_STATE,
-                "方程组有唯一解: rank(A) = rank([A|b]) = n",
-                x
-            ));
+            if (history.isRecording()) {
+                history.addStep(
+                    OperationType::RESULT_STATE,
+                    "方程组有唯一解: rank(A) = rank([A|b]) = n",
+                    x
+                );
+            }
             break;
         }
         
@@ -331,15 +403,16 @@ EquationSolution EquationSolver::solve(const Matrix& A, const Matrix& b, Operati
             solution.setParticularSolution(x_particular);
             solution.setHomogeneousSolutions(x_homogeneous);
             
-            std::stringstream ss;
-            ss << "方程组有无穷多解: rank(A) = rank([A|b]) < n\n";
-            ss << "自由变量个数: " << (info.numVariables - info.coefficientRank);
-            
-            history.addStep(OperationStep(
-                OperationType::RESULT_STATE,
-                ss.str(),
-                augmented
-            ));
+            if (history.isRecording()) {
+                std::stringstream ss;
+                ss << "方程组有无穷多解: rank(A) = rank([A|b]) < n\n";
+                ss << "自由变量个数: " << (info.numVariables - info.coefficientRank);
+                history.addStep(
+                    OperationType::RESULT_STATE,
+                    ss.str(),
+                    augmented
+                );
+            }
             break;
         }
         
@@ -351,8 +424,51 @@ EquationSolution EquationSolver::solve(const Matrix& A, const Matrix& b, Operati
     return solution;
 }
 
+bool MultiEquationSolution::allConsistent() const {
+    return std::find(consistent.begin(), consistent.end(), false) == consistent.end();
+}
+
+MultiEquationSolution EquationSolver::solveMany(const Matrix& A, const Matrix& B) {
+    if (A.rowCount() != B.rowCount()) {
+        throw std::invalid_argument("系数矩阵和常数项的行数不匹配");
+    }
+    size_t n = A.colCount();
+    size_t k = B.colCount();
+
+    std::vector<size_t> pivots;
+    Matrix reduced = MatrixOperations::toReducedRowEchelonForm(A.augment(B), n, pivots);
+
+    MultiEquationSolution result;
+    result.numVariables = static_cast<int>(n);
+    result.coefficientRank = static_cast<int>(pivots.size());
+    result.reducedCoefficients = reduced.extractRightPart(0);
+    result.reducedCoefficients.resize(reduced.rowCount(), n);
+    result.reducedRightHandSides = reduced.extractRightPart(n);
+
+    // 秩以下各行的系数部分全为 0，常数部分非零即无解；有解时主元行的常数部分就是特解
+    result.consistent.assign(k, true);
+    result.particularSolutions = Matrix(n, k);
+    for (size_t j = 0; j < k; ++j) {
+        for (size_t i = pivots.size(); i < reduced.rowCount(); ++i) {
+            if (reduced.at(i, n + j) != Fraction(0)) {
+                result.consistent[j] = false;
+                break;
+            }
+        }
+        if (result.consistent[j]) {
+            for (size_t i = 0; i < pivots.size(); ++i) {
+                result.particularSolutions.at(pivots[i], j) = reduced.at(i, n + j);
+            }
+        }
+    }
+
+    std::vector<int> pivotCols(pivots.begin(), pivots.end());
+    result.homogeneousSolutions = findHomogeneousSolutions(result.reducedCoefficients, pivotCols);
+    return result;
+}
+
 EquationSolution EquationSolver::solveHomogeneous(const Matrix& A) {
-    OperationHistory dummy;
+    NullOperationHistory dummy;
     return solveHomogeneous(A, dummy);
 }
 
@@ -363,11 +479,13 @@ EquationSolution EquationSolver::solveHomogeneous(const Matrix& A, OperationHist
         zero_b.at(i, 0) = Fraction(0);
     }
     
-    history.addStep(OperationStep(
-        OperationType::INITIAL_STATE,
-        "求解齐次线性方程组 Ax = 0",
-        A
-    ));
+    if (history.isRecording()) {
+        history.addStep(
+            OperationType::INITIAL_STATE,
+            "求解齐次线性方程组 Ax = 0",
+            A
+        );
+    }
     
     return solve(A, zero_b, history);
 }
@@ -383,6 +501,11 @@ EquationSystemInfo EquationSolver::analyzeSystem(const Matrix& A, const Matrix&
     Matrix augmented = A.augment(b);
     info.augmentedRank = MatrixOperations::rank(augmented);
     
+    classifySystem(info);
+    return info;
+}
+
+void EquationSolver::classifySystem(EquationSystemInfo& info) {
     // 判断解的性质
     if (info.coefficientRank < info.augmentedRank) {
         info.solutionType = SolutionType::NO_SOLUTION;
@@ -399,8 +522,6 @@ EquationSystemInfo EquationSolver::analyzeSystem(const Matrix& A, const Matrix&
         info.solutionType = SolutionType::UNDETERMINED;
         info.description = "未确定的情况";
     }
-    
-    return info;
 }
 
 EquationSystemInfo EquationSolver::analyzeHomogeneousSystem(const Matrix& A) {
@@ -423,6 +544,35 @@ EquationSystemInfo EquationSolver::analyzeHomogeneousSystem(const Matrix& A) {
     return info;
 }
 
+bool EquationSolver::solveNonsingularSystem(const Matrix& A, const Matrix& b, Matrix& x) {
+    // [A|b] 逐行乘以该行分母的最小公倍数，得到同解的整数方程组
+    size_t n = A.rowCount();
+    std::vector<BigInt> intA(n * n), intB(n);
+    for (size_t i = 0; i < n; ++i) {
+        BigInt scale = b.at(i, 0).getDenominator();
+        for (size_t j = 0; j < n; ++j) {
+            const BigInt& den = A.at(i, j).getDenominator();
+            if (den != 1 && scale % den != 0) {
+                scale = scale / boost::multiprecision::gcd(scale, den) * den;
+            }
+        }
+        for (size_t j = 0; j < n; ++j) {
+            intA[i * n + j] = A.at(i, j).getNumerator() * (scale / A.at(i, j).getDenominator());
+        }
+        intB[i] = b.at(i, 0).getNumerator() * (scale / b.at(i, 0).getDenominator());
+    }
+
+    std::vector<BigInt> numerators;
+    BigInt denominator;
+    if (!ModularOperations::solveNonsingular(intA, intB, n, numerators, denominator)) {
+        return false;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        x.at(i, 0) = Fraction(numerators[i], denominator);
+    }
+    return true;
+}
+
 Matrix EquationSolver::findParticularSolution(const Matrix& rref, const Matrix& b_rref, 
                                              const std::vector<int>& pivotCols) {
     size_t n = rref.colCount();
@@ -484,11 +634,11 @@ Matrix EquationSolver::findHomogeneousSolutions(const Matrix& rref,
         // 计算基本变量的值
         for (size_t i = 0; i < numPivots && i < rref.rowCount(); ++i) {
             if (pivotCols[i] >= 0 && pivotCols[i] < static_cast<int>(n)) {
-                Fraction value(0);
+                RationalAccumulator value;
                 for (size_t j = pivotCols[i] + 1; j < n; ++j) {
-                    value = value - rref.at(i, j) * solutions.at(j, k);
+                    value.fms(rref.at(i, j), solutions.at(j, k));
                 }
-                solutions.at(pivotCols[i], k) = value;
+                solutions.at(pivotCols[i], k) = value.result();
             }
         }
     }
@@ -4,6 +4,7 @@
 #include "fraction.h"
 #include "result.h"
 #include "operation_step.h"
+#include "factorization.h"
 #include <vector>
 #include <string>
 
@@ -71,6 +72,25 @@ public:
     static EquationSolution deserialize(const std::string& s);
 };
 
+// 新增：多右端项方程组 A X = B 的求解结果，B 的每一列对应一个方程组，共用对 [A|B] 的一次消元
+struct MultiEquationSolution {
+    int numVariables;
+    int coefficientRank;
+    std::vector<bool> consistent;  // 第 j 列对应的方程组是否有解
+    Matrix particularSolutions;    // 各列的特解（自由变量取 0），无解的列为 0
+    Matrix homogeneousSolutions;   // A 的基础解系，各列共用；满列秩时为 n x 0
+    Matrix reducedCoefficients;    // rref(A)
+    Matrix reducedRightHandSides;  // 与 rref(A) 同步行变换后的 B
+
+    MultiEquationSolution()
+        : numVariables(0), coefficientRank(0), particularSolutions(0, 0), homogeneousSolutions(0, 0),
+          reducedCoefficients(0, 0), reducedRightHandSides(0, 0) {}
+
+    bool allConsistent() const;
+    // 每一列都有唯一解
+    bool hasUniqueSolutions() const { return allConsistent() && coefficientRank == numVariables; }
+};
+
 // 方程组求解器
 class EquationSolver {
 public:
@@ -80,7 +100,12 @@ public:
     // 新增：重载以接受 Vector b
     static EquationSolution solve(const Matrix& A, const Vector& b);
     static EquationSolution solve(const Matrix& A, const Vector& b, OperationHistory& history);
+    // 新增：复用已有的 PLU 分解求解，只做前代/回代
+    static EquationSolution solve(const Factorization& factors, const Matrix& b);
     
+    // 新增：同时求解 A X = B 的每一列，只对 [A|B] 消元一次
+    static MultiEquationSolution solveMany(const Matrix& A, const Matrix& B);
+
     // 求解齐次线性方程组 Ax = 0
     static EquationSolution solveHomogeneous(const Matrix& A);
     static EquationSolution solveHomogeneous(const Matrix& A, OperationHistory& history);
@@ -91,6 +116,10 @@ public:
     
 private:
     // 内部辅助方法
+    // 新增：由秩判断解的性质
+    static void classifySystem(EquationSystemInfo& info);
+    // 新增：Dixon p-adic 提升求解非奇异方阵方程组，A 奇异时返回 false
+    static bool solveNonsingularSystem(const Matrix& A, const Matrix& b, Matrix& x);
     static Matrix findParticularSolution(const Matrix& rref, const Matrix& b_rref, 
                                         const std::vector<int>& pivotCols);
     static Matrix findHomogeneousSolutions(const Matrix& rref, 
@@ -0,0 +1,212 @@
+#include "factorization.h"
+#include "task_scheduler.h"
+#include "cancellation.h"
+#include "progress.h"
+#include <algorithm>
+#include <stdexcept>
+#include <boost/multiprecision/integer.hpp>
+
+Factorization::Factorization(const Matrix& A)
+    : rows(A.rowCount()), cols(A.colCount()), original(A),
+      lower(0, 0), upper(0, 0), sign(1) {
+    // 每行乘以该行分母的最小公倍数，得到整数工作矩阵
+    std::vector<BigInt> work(rows * cols);
+    rowScale.assign(rows, Fraction(1));
+    for (size_t i = 0; i < rows; ++i) {
+        BigInt scale = 1;
+        for (size_t j = 0; j < cols; ++j) {
+            const BigInt& den = A.at(i, j).getDenominator();
+            if (den != 1 && scale % den != 0) {
+                scale = scale / boost::multiprecision::gcd(scale, den) * den;
+            }
+        }
+        for (size_t j = 0; j < cols; ++j) {
+            const Fraction& value = A.at(i, j);
+            work[i * cols + j] = value.getDenominator() == scale
+                ? value.getNumerator()
+                : BigInt(value.getNumerator() * (scale / value.getDenominator()));
+        }
+        rowScale[i] = Fraction(scale);
+    }
+
+    rowOrder.resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        rowOrder[i] = i;
+    }
+
+    // Bareiss 消元，同时记录 L 的各列：第 k 步时主元列在第 k 行及以下的值
+    size_t maxRank = std::min(rows, cols);
+    std::vector<BigInt> lowerInt(rows * maxRank);
+    BigInt prevPivot = 1;
+    BigInt tmp;
+    size_t r = 0;
+    for (size_t c = 0; c < cols && r < rows; ++c) {
+        Cancellation::checkpoint();
+        Progress::report("PLU 分解: 主元列", c + 1, cols);
+        size_t p = r;
+        while (p < rows && work[p * cols + c] == 0) {
+            ++p;
+        }
+        if (p == rows) {
+            continue;
+        }
+        if (p != r) {
+            std::swap_ranges(work.begin() + p * cols, work.begin() + (p + 1) * cols, work.begin() + r * cols);
+            std::swap_ranges(lowerInt.begin() + p * maxRank, lowerInt.begin() + p * maxRank + r, lowerInt.begin() + r * maxRank);
+            std::swap(rowOrder[p], rowOrder[r]);
+            sign = -sign;
+        }
+
+        const BigInt pivot = work[r * cols + c];
+        lowerInt[r * maxRank + r] = pivot;
+        for (size_t i = r + 1; i < rows; ++i) {
+            const BigInt factor = work[i * cols + c];
+            lowerInt[i * maxRank + r] = factor;
+            for (size_t j = c + 1; j < cols; ++j) {
+                tmp = pivot * work[i * cols + j];
+                if (factor != 0) {
+                    tmp -= factor * work[r * cols + j];
+                }
+                if (prevPivot != 1) {
+                    tmp /= prevPivot;
+                }
+                work[i * cols + j].swap(tmp);
+            }
+            work[i * cols + c] = 0;
+        }
+
+        diag.push_back(Fraction(BigInt(prevPivot * pivot)));
+        prevPivot = pivot;
+        pivotCols.push_back(c);
+        ++r;
+    }
+
+    lower = Matrix(rows, r);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t k = 0; k < r && k <= i; ++k) {
+            lower.at(i, k) = Fraction(lowerInt[i * maxRank + k]);
+        }
+    }
+    upper = Matrix(r, cols);
+    for (size_t k = 0; k < r; ++k) {
+        for (size_t j = pivotCols[k]; j < cols; ++j) {
+            upper.at(k, j) = Fraction(work[k * cols + j]);
+        }
+    }
+}
+
+Fraction Factorization::det() const {
+    if (rows != cols) {
+        throw std::invalid_argument("Determinant can only be calculated for square matrices");
+    }
+    if (rows == 0) {
+        return Fraction(1);
+    }
+    if (pivotCols.size() < rows) {
+        return Fraction(0);
+    }
+    // Bareiss 的最后一个主元即 det(P M)
+    BigInt scale = 1;
+    for (const auto& s : rowScale) {
+        scale *= s.getNumerator();
+    }
+    const BigInt& last = upper.at(rows - 1, rows - 1).getNumerator();
+    return Fraction(sign > 0 ? last : BigInt(-last), scale);
+}
+
+Matrix Factorization::solveMany(const Matrix& B, std::vector<bool>& consistent) const {
+    if (B.rowCount() != rows) {
+        throw std::invalid_argument("系数矩阵和常数项的行数不匹配");
+    }
+    size_t r = pivotCols.size();
+    Matrix X(cols, B.colCount());
+    // vector<bool> 按位存储，不同线程写相邻的列会互相干扰，先用逐字节的标记
+    std::vector<char> solvable(B.colCount(), 1);
+
+    // 各列的前代、回代互不依赖，交给线程池并行
+    TaskScheduler::parallelFor(0, B.colCount(), [&](size_t col) {
+        std::vector<Fraction> rhs(rows), w(r);
+        for (size_t k = 0; k < rows; ++k) {
+            const Fraction& value = B.at(rowOrder[k], col);
+            rhs[k] = value == Fraction(0) ? value : value * rowScale[rowOrder[k]];
+        }
+
+        // 前代：L w = P S b
+        for (size_t k = 0; k < r; ++k) {
+            RationalAccumulator acc(rhs[k]);
+            for (size_t j = 0; j < k; ++j) {
+                acc.fms(lower.at(k, j), w[j]);
+            }
+            w[k] = acc.result() / lower.at(k, k);
+        }
+        // 秩以下的方程只用来检验相容性
+        for (size_t i = r; i < rows; ++i) {
+            RationalAccumulator acc(rhs[i]);
+            for (size_t j = 0; j < r; ++j) {
+                acc.fms(lower.at(i, j), w[j]);
+            }
+            if (acc.result() != Fraction(0)) {
+                solvable[col] = 0;
+                return;
+            }
+        }
+
+        // 回代：U x = D w，自由变量取 0
+        for (size_t k = r; k-- > 0;) {
+            RationalAccumulator acc(w[k] * diag[k]);
+            for (size_t j = pivotCols[k] + 1; j < cols; ++j) {
+                acc.fms(upper.at(k, j), X.at(j, col));
+            }
+            X.at(pivotCols[k], col) = acc.result() / upper.at(k, pivotCols[k]);
+        }
+    });
+
+    consistent.assign(solvable.begin(), solvable.end());
+    return X;
+}
+
+bool Factorization::solve(const Matrix& b, Matrix& x) const {
+    if (b.colCount() != 1) {
+        throw std::invalid_argument("常数项必须是列向量(nx1矩阵)");
+    }
+    std::vector<bool> consistent;
+    x = solveMany(b, consistent);
+    return consistent[0];
+}
+
+Matrix Factorization::inverse() const {
+    if (rows != cols) {
+        throw std::invalid_argument("Inverse can only be calculated for square matrices");
+    }
+    if (pivotCols.size() < rows) {
+        throw std::runtime_error("Matrix is not invertible (determinant is zero)");
+    }
+    std::vector<bool> consistent;
+    return solveMany(Matrix::identity(rows), consistent);
+}
+
+Matrix Factorization::nullspace() const {
+    size_t r = pivotCols.size();
+    std::vector<bool> isPivot(cols, false);
+    for (size_t c : pivotCols) {
+        isPivot[c] = true;
+    }
+
+    Matrix basis(cols, cols - r);
+    size_t k = 0;
+    for (size_t f = 0; f < cols; ++f) {
+        if (isPivot[f]) {
+            continue;
+        }
+        basis.at(f, k) = Fraction(1);
+        for (size_t p = r; p-- > 0;) {
+            RationalAccumulator acc;
+            for (size_t j = pivotCols[p] + 1; j < cols; ++j) {
+                acc.fms(upper.at(p, j), basis.at(j, k));
+            }
+            basis.at(pivotCols[p], k) = acc.result() / upper.at(p, pivotCols[p]);
+        }
+        ++k;
+    }
+    return basis;
+}
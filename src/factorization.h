@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include "matrix.h"
+#include "fraction.h"
+
+// 精确 PLU 分解（无分数 LU）：先把每行通分为整数得到 M = S A，再做 Bareiss 消元，得到
+//     P M = L D^{-1} U
+// 其中 L（m x r）、U（r x n）均为整数矩阵，D_k = p_{k-1} p_k（p_k 为第 k 个主元，p_{-1} = 1），
+// r 为秩，pivotColumns() 为秩轮廓（各主元所在列）。
+// 分解只做一次，之后的行列式、求解、求逆、求秩、零空间都只需前代/回代，不再重新消元。
+class Factorization {
+public:
+    explicit Factorization(const Matrix& A);
+
+    size_t rowCount() const { return rows; }
+    size_t colCount() const { return cols; }
+    const Matrix& matrix() const { return original; }
+
+    int rank() const { return static_cast<int>(pivotCols.size()); }
+    const std::vector<size_t>& pivotColumns() const { return pivotCols; }
+
+    // 行列式，非方阵抛出 std::invalid_argument
+    Fraction det() const;
+
+    // 求 A x = b 的一个特解（自由变量取 0），b 为 m x 1；无解时返回 false
+    bool solve(const Matrix& b, Matrix& x) const;
+
+    // 对 B 的每一列分别求特解，consistent[j] 表示第 j 列是否有解（无解的列填 0）
+    Matrix solveMany(const Matrix& B, std::vector<bool>& consistent) const;
+
+    // 逆矩阵，非方阵抛出 std::invalid_argument，奇异时抛出 std::runtime_error
+    Matrix inverse() const;
+
+    // 零空间的基础解系（按列排列，每个自由变量取 1、其余自由变量取 0），满列秩时为 n x 0
+    Matrix nullspace() const;
+
+private:
+    size_t rows, cols;
+    Matrix original;
+    std::vector<Fraction> rowScale;   // S 的对角元
+    std::vector<size_t> rowOrder;     // P：分解后第 k 行对应原矩阵的第 rowOrder[k] 行
+    std::vector<size_t> pivotCols;
+    Matrix lower;                     // L，m x r
+    Matrix upper;                     // U，r x n
+    std::vector<Fraction> diag;       // D
+    int sign;                         // P 的行列式
+};
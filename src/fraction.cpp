@@ -1,53 +1,123 @@
 #include "fraction.h"
+#include "integer_factorization.h"
 #include <stdexcept>
 #include <sstream>
+#include <limits>
+#include <algorithm>
 #include <boost/multiprecision/integer.hpp>
 
 // 计算最大公约数的函数，适用于 cpp_int
+// 使用二进制 GCD（Stein 算法）：只做原地移位和减法，不在循环中构造临时 BigInt；
+// 两个操作数都缩小到 64 位以内后转入机器字运算
+static unsigned long long binary_gcd_u64(unsigned long long u, unsigned long long v) {
+    if (u == 0) return v;
+    if (v == 0) return u;
+    int shift = __builtin_ctzll(u | v);
+    u >>= __builtin_ctzll(u);
+    do {
+        v >>= __builtin_ctzll(v);
+        if (u > v) {
+            unsigned long long t = u;
+            u = v;
+            v = t;
+        }
+        v -= u;
+    } while (v != 0);
+    return u << shift;
+}
+
 BigInt gcd(const BigInt& a, const BigInt& b) {
-    BigInt abs_a = abs(a);
-    BigInt abs_b = abs(b);
-    
-    while (abs_b != 0) {
-        BigInt temp = abs_b;
-        abs_b = abs_a % abs_b;
-        abs_a = temp;
+    if (a == 0) return abs(b);
+    if (b == 0) return abs(a);
+
+    BigInt u = abs(a);
+    BigInt v = abs(b);
+    unsigned shift = std::min(boost::multiprecision::lsb(u), boost::multiprecision::lsb(v));
+    u >>= boost::multiprecision::lsb(u);
+
+    while (true) {
+        v >>= boost::multiprecision::lsb(v);
+        if (boost::multiprecision::msb(u) < 64 && boost::multiprecision::msb(v) < 64) {
+            BigInt result = binary_gcd_u64(u.convert_to<unsigned long long>(), v.convert_to<unsigned long long>());
+            result <<= shift;
+            return result;
+        }
+        if (u > v) {
+            u.swap(v);
+        }
+        v -= u;
+        if (v == 0) {
+            break;
+        }
     }
-    return abs_a;
+    u <<= shift;
+    return u;
 }
 
 // 新增：自定义的整数n次方根函数
-// 返回 floor(n^(1/r))
+// 返回 floor(n^(1/r))，由 IntegerFactorization 的牛顿迭代完成
 static BigInt integer_nth_root(const BigInt& n, unsigned int r) {
     if (n < 0) {
         throw std::runtime_error("Nth root of a negative number is not supported in this context.");
     }
-    if (n == 0) return 0;
-    if (r == 1) return n;
     if (r == 0) throw std::runtime_error("Cannot compute 0th root.");
+    return IntegerFactorization::integerRoot(n, r);
+}
 
-    BigInt low = 1;
-    BigInt high = n;
-    BigInt root = 1;
+// 小整数快速路径的辅助函数
+namespace {
+    // 快速路径只使用 [-(2^63-1), 2^63-1]，避开 LLONG_MIN 以保证取负安全
+    const BigInt SMALL_MAX = BigInt(std::numeric_limits<long long>::max());
+    const BigInt SMALL_MIN = -SMALL_MAX;
 
-    while (low <= high) {
-        BigInt mid = low + (high - low) / 2;
-        if (mid == 0) { // Should not happen if low starts at 1
-            break;
+    inline bool fitsSmall(const BigInt& v) {
+        return v >= SMALL_MIN && v <= SMALL_MAX;
+    }
+
+    // 要求参数不为 LLONG_MIN
+    inline long long smallGcd(long long a, long long b) {
+        unsigned long long x = a < 0 ? static_cast<unsigned long long>(-a) : static_cast<unsigned long long>(a);
+        unsigned long long y = b < 0 ? static_cast<unsigned long long>(-b) : static_cast<unsigned long long>(b);
+        return static_cast<long long>(binary_gcd_u64(x, y));
+    }
+
+    // (an/ad) * (bn/bd)，分母均为正且两个输入均已化简；溢出时返回 false
+    inline bool mulReduced(long long an, long long ad, long long bn, long long bd,
+                           long long& outNum, long long& outDen) {
+        if (an == 0 || bn == 0) {
+            outNum = 0;
+            outDen = 1;
+            return true;
         }
-        
-        BigInt p = boost::multiprecision::pow(mid, r);
-
-        if (p > n) {
-            high = mid - 1;
-        } else if (p < n) {
-            root = mid;
-            low = mid + 1;
-        } else { // p == n
-            return mid;
+        long long g1 = smallGcd(an, bd);
+        long long g2 = smallGcd(bn, ad);
+        if (__builtin_mul_overflow(an / g1, bn / g2, &outNum) ||
+            __builtin_mul_overflow(ad / g2, bd / g1, &outDen) ||
+            outNum == std::numeric_limits<long long>::min()) {
+            return false;
         }
+        return true;
+    }
+}
+
+void Fraction::setSmall(long long num, long long den) {
+    smallNum = num;
+    smallDen = den;
+    isSmall = true;
+    pendingReduce = false;
+    numerator = num;
+    denominator = den;
+}
+
+void Fraction::demoteIfSmall() {
+    pendingReduce = false;
+    if (fitsSmall(numerator) && fitsSmall(denominator)) {
+        smallNum = numerator.convert_to<long long>();
+        smallDen = denominator.convert_to<long long>();
+        isSmall = true;
+    } else {
+        isSmall = false;
     }
-    return root;
 }
 
 void Fraction::simplify() {
@@ -55,7 +125,22 @@ void Fraction::simplify() {
         throw std::runtime_error("Denominator cannot be zero in simplify.");
     }
     if (numerator == 0) {
-        denominator = 1;
+        setSmall(0, 1);
+        return;
+    }
+
+    // 能放进 int64 的情况直接在快速路径上化简
+    if (fitsSmall(numerator) && fitsSmall(denominator)) {
+        long long num = numerator.convert_to<long long>();
+        long long den = denominator.convert_to<long long>();
+        long long g = smallGcd(num, den);
+        num /= g;
+        den /= g;
+        if (den < 0) {
+            num = -num;
+            den = -den;
+        }
+        setSmall(num, den);
         return;
     }
 
@@ -68,14 +153,17 @@ void Fraction::simplify() {
         numerator = -numerator;
         denominator = -denominator;
     }
+    demoteIfSmall();
 }
 
 // 构造函数
-Fraction::Fraction() : numerator(0), denominator(1) {}
+Fraction::Fraction() : smallNum(0), smallDen(1), isSmall(true), pendingReduce(false), numerator(0), denominator(1) {}
 
-Fraction::Fraction(const BigInt& num) : numerator(num), denominator(1) {}
+Fraction::Fraction(const BigInt& num) : smallNum(0), smallDen(1), isSmall(false), pendingReduce(false), numerator(num), denominator(1) {
+    demoteIfSmall();
+}
 
-Fraction::Fraction(const BigInt& num, const BigInt& den) : numerator(num), denominator(den) {
+Fraction::Fraction(const BigInt& num, const BigInt& den) : smallNum(0), smallDen(1), isSmall(false), pendingReduce(false), numerator(num), denominator(den) {
     if (den == 0) {
         throw std::invalid_argument("Denominator cannot be zero.");
     }
@@ -83,9 +171,13 @@ Fraction::Fraction(const BigInt& num, const BigInt& den) : numerator(num), denom
 }
 
 // 为了向后兼容的构造函数
-Fraction::Fraction(long long num) : numerator(BigInt(num)), denominator(1) {}
+Fraction::Fraction(long long num) : smallNum(num), smallDen(1), isSmall(true), pendingReduce(false), numerator(num), denominator(1) {
+    if (num == std::numeric_limits<long long>::min()) {
+        isSmall = false;
+    }
+}
 
-Fraction::Fraction(long long num, long long den) : numerator(BigInt(num)), denominator(BigInt(den)) {
+Fraction::Fraction(long long num, long long den) : smallNum(0), smallDen(1), isSmall(false), pendingReduce(false), numerator(num), denominator(den) {
     if (den == 0) {
         throw std::invalid_argument("Denominator cannot be zero.");
     }
@@ -93,13 +185,11 @@ Fraction::Fraction(long long num, long long den) : numerator(BigInt(num)), denom
 }
 
 // 新增：从字符串构造
-Fraction::Fraction(const std::string& s) {
+Fraction::Fraction(const std::string& s) : smallNum(0), smallDen(1), isSmall(true), pendingReduce(false), numerator(0), denominator(1) {
     std::string temp_s = s;
     // 移除可能存在的前后空格
     auto first = temp_s.find_first_not_of(" \t\n\r");
     if (std::string::npos == first) { // string is all whitespace or empty
-        numerator = 0;
-        denominator = 1;
         return;
     }
     auto last = temp_s.find_last_not_of(" \t\n\r");
@@ -110,6 +200,7 @@ Fraction::Fraction(const std::string& s) {
         // 没有斜杠，是整数
         numerator = BigInt(temp_s);
         denominator = 1;
+        demoteIfSmall();
     } else {
         // 有斜杠，是分数
         std::string num_str = temp_s.substr(0, slash_pos);
@@ -137,20 +228,93 @@ const BigInt& Fraction::getDenominator() const {
     return denominator;
 }
 
+// 快速路径：a/b ± c/d，先约去分母的公因子以减少溢出
+bool Fraction::addSmall(const Fraction& a, const Fraction& b, bool negateB, Fraction& out) {
+    long long c = negateB ? -b.smallNum : b.smallNum;
+    long long g = smallGcd(a.smallDen, b.smallDen);
+    long long aDen = a.smallDen / g;
+    long long bDen = b.smallDen / g;
+
+    long long t1, t2, t;
+    if (__builtin_mul_overflow(a.smallNum, bDen, &t1) ||
+        __builtin_mul_overflow(c, aDen, &t2) ||
+        __builtin_add_overflow(t1, t2, &t) ||
+        t == std::numeric_limits<long long>::min()) {
+        return false;
+    }
+    if (t == 0) {
+        out.setSmall(0, 1);
+        return true;
+    }
+
+    // gcd(t, lcm(b, d)) == gcd(t, g)
+    long long g2 = (g == 1) ? 1 : smallGcd(t, g);
+    long long den;
+    if (__builtin_mul_overflow(a.smallDen / g2, bDen, &den)) {
+        return false;
+    }
+    out.setSmall(t / g2, den);
+    return true;
+}
+
+bool Fraction::mulSmall(const Fraction& a, const Fraction& b, Fraction& out) {
+    long long num, den;
+    if (!mulReduced(a.smallNum, a.smallDen, b.smallNum, b.smallDen, num, den)) {
+        return false;
+    }
+    out.setSmall(num, den);
+    return true;
+}
+
+bool Fraction::divSmall(const Fraction& a, const Fraction& b, Fraction& out) {
+    // 取 b 的倒数，保持分母为正
+    long long invNum = b.smallNum < 0 ? -b.smallDen : b.smallDen;
+    long long invDen = b.smallNum < 0 ? -b.smallNum : b.smallNum;
+    long long num, den;
+    if (!mulReduced(a.smallNum, a.smallDen, invNum, invDen, num, den)) {
+        return false;
+    }
+    out.setSmall(num, den);
+    return true;
+}
+
+int Fraction::compare(const Fraction& other) const {
+    if (isSmall && other.isSmall) {
+        __int128 lhs = static_cast<__int128>(smallNum) * other.smallDen;
+        __int128 rhs = static_cast<__int128>(other.smallNum) * smallDen;
+        return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+    }
+    BigInt lhs = numerator * other.denominator;
+    BigInt rhs = other.numerator * denominator;
+    return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
 // 算术运算符重载
 Fraction Fraction::operator+(const Fraction& other) const {
+    Fraction result;
+    if (isSmall && other.isSmall && addSmall(*this, other, false, result)) {
+        return result;
+    }
     BigInt new_num = numerator * other.denominator + other.numerator * denominator;
     BigInt new_den = denominator * other.denominator;
     return Fraction(new_num, new_den);
 }
 
 Fraction Fraction::operator-(const Fraction& other) const {
+    Fraction result;
+    if (isSmall && other.isSmall && addSmall(*this, other, true, result)) {
+        return result;
+    }
     BigInt new_num = numerator * other.denominator - other.numerator * denominator;
     BigInt new_den = denominator * other.denominator;
     return Fraction(new_num, new_den);
 }
 
 Fraction Fraction::operator*(const Fraction& other) const {
+    Fraction result;
+    if (isSmall && other.isSmall && mulSmall(*this, other, result)) {
+        return result;
+    }
     BigInt new_num = numerator * other.numerator;
     BigInt new_den = denominator * other.denominator;
     return Fraction(new_num, new_den);
@@ -160,6 +324,10 @@ Fraction Fraction::operator/(const Fraction& other) const {
     if (other.numerator == 0) {
         throw std::runtime_error("Division by zero fraction.");
     }
+    Fraction result;
+    if (isSmall && other.isSmall && divSmall(*this, other, result)) {
+        return result;
+    }
     BigInt new_num = numerator * other.denominator;
     BigInt new_den = denominator * other.numerator;
     return Fraction(new_num, new_den);
@@ -186,8 +354,79 @@ Fraction& Fraction::operator/=(const Fraction& other) {
     return *this;
 }
 
+// 延迟化简：仅在 BigInt 路径上推迟约分，两个操作数都在快速路径时直接使用普通运算
+void Fraction::reduceIfOversized() {
+    if (boost::multiprecision::msb(denominator) > DEFERRED_REDUCE_BITS ||
+        (numerator != 0 && boost::multiprecision::msb(abs(numerator)) > DEFERRED_REDUCE_BITS)) {
+        simplify();
+    }
+}
+
+// 加减共用：分母相同或互为倍数时直接在较大的分母上累加，避免分母无谓膨胀
+Fraction& Fraction::accumulateDeferred(const Fraction& other, bool negate) {
+    if (isSmall && other.isSmall) {
+        return negate ? (*this -= other) : (*this += other);
+    }
+    if (denominator == other.denominator) {
+        if (negate) numerator -= other.numerator;
+        else numerator += other.numerator;
+    } else if (denominator % other.denominator == 0) {
+        BigInt term = other.numerator * (denominator / other.denominator);
+        if (negate) numerator -= term;
+        else numerator += term;
+    } else if (other.denominator % denominator == 0) {
+        numerator *= other.denominator / denominator;
+        denominator = other.denominator;
+        if (negate) numerator -= other.numerator;
+        else numerator += other.numerator;
+    } else {
+        BigInt term = other.numerator * denominator;
+        numerator *= other.denominator;
+        denominator *= other.denominator;
+        if (negate) numerator -= term;
+        else numerator += term;
+    }
+    isSmall = false;
+    pendingReduce = true;
+    reduceIfOversized();
+    return *this;
+}
+
+Fraction& Fraction::addDeferred(const Fraction& other) {
+    return accumulateDeferred(other, false);
+}
+
+Fraction& Fraction::subDeferred(const Fraction& other) {
+    return accumulateDeferred(other, true);
+}
+
+Fraction& Fraction::mulDeferred(const Fraction& other) {
+    if (isSmall && other.isSmall) {
+        return *this *= other;
+    }
+    numerator *= other.numerator;
+    denominator *= other.denominator;
+    isSmall = false;
+    pendingReduce = true;
+    reduceIfOversized();
+    return *this;
+}
+
+Fraction& Fraction::normalize() {
+    if (pendingReduce) {
+        simplify();
+    }
+    return *this;
+}
+
 // 比较运算符
 bool Fraction::operator==(const Fraction& other) const {
+    if (isSmall && other.isSmall) {
+        return smallNum == other.smallNum && smallDen == other.smallDen;
+    }
+    if (pendingReduce || other.pendingReduce) {
+        return compare(other) == 0;
+    }
     return numerator == other.numerator && denominator == other.denominator;
 }
 
@@ -196,28 +435,42 @@ bool Fraction::operator!=(const Fraction& other) const {
 }
 
 bool Fraction::operator<(const Fraction& other) const {
-    return numerator * other.denominator < other.numerator * denominator;
+    return compare(other) < 0;
 }
 
 bool Fraction::operator<=(const Fraction& other) const {
-    return numerator * other.denominator <= other.numerator * denominator;
+    return compare(other) <= 0;
 }
 
 bool Fraction::operator>(const Fraction& other) const {
-    return numerator * other.denominator > other.numerator * denominator;
+    return compare(other) > 0;
 }
 
 bool Fraction::operator>=(const Fraction& other) const {
-    return numerator * other.denominator >= other.numerator * denominator;
+    return compare(other) >= 0;
 }
 
 // 一元负号运算符
 Fraction Fraction::operator-() const {
+    if (isSmall) {
+        Fraction result;
+        result.setSmall(-smallNum, smallDen);
+        return result;
+    }
     return Fraction(-numerator, denominator);
 }
 
 // 转换为字符串
 std::string Fraction::toString() const {
+    if (pendingReduce) {
+        return Fraction(*this).normalize().toString();
+    }
+    if (isSmall) {
+        if (smallDen == 1) {
+            return std::to_string(smallNum);
+        }
+        return std::to_string(smallNum) + "/" + std::to_string(smallDen);
+    }
     if (denominator == 1) {
         return numerator.str();
     } else {
@@ -231,6 +484,117 @@ std::ostream& operator<<(std::ostream& os, const Fraction& f) {
     return os;
 }
 
+// 有理数累加器
+namespace {
+    // num/den += p/q，den 与 q 均为正；溢出时返回 false 且不修改 num/den
+    bool accumulateSmall(long long& num, long long& den, long long p, long long q) {
+        long long n, d, t1, t2;
+        if (den == q) {
+            if (__builtin_add_overflow(num, p, &n)) return false;
+            d = den;
+        } else if (den % q == 0) {
+            if (__builtin_mul_overflow(p, den / q, &t1) || __builtin_add_overflow(num, t1, &n)) return false;
+            d = den;
+        } else if (q % den == 0) {
+            if (__builtin_mul_overflow(num, q / den, &t1) || __builtin_add_overflow(t1, p, &n)) return false;
+            d = q;
+        } else {
+            long long g = static_cast<long long>(binary_gcd_u64(static_cast<unsigned long long>(den),
+                                                                static_cast<unsigned long long>(q)));
+            if (__builtin_mul_overflow(num, q / g, &t1) ||
+                __builtin_mul_overflow(p, den / g, &t2) ||
+                __builtin_add_overflow(t1, t2, &n) ||
+                __builtin_mul_overflow(den / g, q, &d)) {
+                return false;
+            }
+        }
+        if (n == 0) {
+            d = 1; // 运行和归零时重置公共分母
+        }
+        num = n;
+        den = d;
+        return true;
+    }
+}
+
+RationalAccumulator::RationalAccumulator() : num(0), den(1), isSmall(true), big() {}
+
+RationalAccumulator::RationalAccumulator(const Fraction& init) : num(0), den(1), isSmall(true), big() {
+    add(init);
+}
+
+void RationalAccumulator::reset() {
+    num = 0;
+    den = 1;
+    isSmall = true;
+    big = Fraction();
+}
+
+void RationalAccumulator::promote() {
+    big = Fraction(num, den);
+    isSmall = false;
+}
+
+void RationalAccumulator::addTerm(const Fraction& a, const Fraction& b, bool negate) {
+    if (a.isSmall && b.isSmall && (a.smallNum == 0 || b.smallNum == 0)) {
+        return;
+    }
+    if (isSmall && a.isSmall && b.isSmall) {
+        long long p, q;
+        if (!__builtin_mul_overflow(a.smallNum, b.smallNum, &p) &&
+            !__builtin_mul_overflow(a.smallDen, b.smallDen, &q) &&
+            !(negate && __builtin_sub_overflow(0LL, p, &p)) &&
+            accumulateSmall(num, den, p, q)) {
+            return;
+        }
+    }
+    if (isSmall) {
+        promote();
+    }
+    Fraction term(a);
+    term.mulDeferred(b);
+    big.accumulateDeferred(term, negate);
+}
+
+RationalAccumulator& RationalAccumulator::add(const Fraction& x) {
+    if (isSmall && x.isSmall && accumulateSmall(num, den, x.smallNum, x.smallDen)) {
+        return *this;
+    }
+    if (isSmall) {
+        promote();
+    }
+    big.accumulateDeferred(x, false);
+    return *this;
+}
+
+RationalAccumulator& RationalAccumulator::sub(const Fraction& x) {
+    if (isSmall && x.isSmall && accumulateSmall(num, den, -x.smallNum, x.smallDen)) {
+        return *this;
+    }
+    if (isSmall) {
+        promote();
+    }
+    big.accumulateDeferred(x, true);
+    return *this;
+}
+
+RationalAccumulator& RationalAccumulator::fma(const Fraction& a, const Fraction& b) {
+    addTerm(a, b, false);
+    return *this;
+}
+
+RationalAccumulator& RationalAccumulator::fms(const Fraction& a, const Fraction& b) {
+    addTerm(a, b, true);
+    return *this;
+}
+
+Fraction RationalAccumulator::result() const {
+    if (isSmall) {
+        return Fraction(num, den);
+    }
+    return Fraction(big).normalize();
+}
+
 // 新增：数学函数
 // 帮助函数：检查 BigInt 是否为完美平方数
 static bool is_perfect_square_bigint(const BigInt& n) {
@@ -300,10 +664,9 @@ Fraction nth_root(const Fraction& f, long long n) {
 // 检查分数是否为完美n次方数
 bool is_perfect_nth_root(const Fraction& f, long long n) {
     if (f.getNumerator() < 0 && n % 2 == 0) return false;
-    
-    BigInt num_root = integer_nth_root(abs(f.getNumerator()), n);
-    BigInt den_root = integer_nth_root(f.getDenominator(), n);
-    
-    return boost::multiprecision::pow(num_root, n) == abs(f.getNumerator()) &&
-           boost::multiprecision::pow(den_root, n) == f.getDenominator();
+    if (n <= 0) throw std::runtime_error("Cannot compute 0th root.");
+
+    // 小素因子的重数不是 n 的倍数时直接否定，不必求根
+    return IntegerFactorization::isPerfectPower(f.getNumerator(), static_cast<unsigned>(n)) &&
+           IntegerFactorization::isPerfectPower(f.getDenominator(), static_cast<unsigned>(n));
 }
\ No newline at end of file
@@ -9,10 +9,30 @@ using BigInt = boost::multiprecision::cpp_int;
 
 class Fraction {
 private:
+    // 小整数快速路径：分子分母都能放进 int64 时直接用内联字段运算，
+    // 溢出时自动提升到 BigInt；大数结果重新落回 int64 范围时再降级。
+    long long smallNum;
+    long long smallDen;
+    bool isSmall;
+    bool pendingReduce; // 延迟化简模式下尚未约分
+
+    // BigInt 形式始终与当前值保持一致，getNumerator()/getDenominator() 返回其引用
     BigInt numerator;
     BigInt denominator;
 
     void simplify(); // 用于化简分数
+    void setSmall(long long num, long long den); // 设置已化简的小整数值并同步 BigInt
+    void demoteIfSmall(); // 大数结果落回 int64 范围时切换回快速路径
+
+    // 快速路径运算，溢出时返回 false，由调用方退回 BigInt 路径
+    static bool addSmall(const Fraction& a, const Fraction& b, bool negateB, Fraction& out);
+    static bool mulSmall(const Fraction& a, const Fraction& b, Fraction& out);
+    static bool divSmall(const Fraction& a, const Fraction& b, Fraction& out);
+    int compare(const Fraction& other) const; // 返回 -1, 0, 1
+    void reduceIfOversized(); // 延迟化简时位数超过阈值则立即约分
+    Fraction& accumulateDeferred(const Fraction& other, bool negate);
+
+    friend class RationalAccumulator;
 
 public:
     // 构造函数
@@ -43,6 +63,16 @@ public:
     Fraction& operator*=(const Fraction& other);
     Fraction& operator/=(const Fraction& other);
 
+    // 新增：延迟化简模式，用于累加循环。运算结果暂不约分，只在分子或分母
+    // 位数超过 DEFERRED_REDUCE_BITS 时才约分；循环结束后必须调用 normalize()。
+    // 未化简期间 getNumerator()/getDenominator() 返回的是未约分的值。
+    static const unsigned DEFERRED_REDUCE_BITS = 512;
+    Fraction& addDeferred(const Fraction& other);
+    Fraction& subDeferred(const Fraction& other);
+    Fraction& mulDeferred(const Fraction& other);
+    Fraction& normalize();
+    bool isNormalized() const { return !pendingReduce; }
+
     // 比较运算符
     bool operator==(const Fraction& other) const;
     bool operator!=(const Fraction& other) const;
@@ -61,6 +91,31 @@ public:
     std::string toString() const;
 };
 
+// 新增：有理数累加器，用于点积形状的循环（矩阵乘法、点乘、行变换、回代）。
+// 在一个公共分母（各项分母的最小公倍数）上维护运行分子，只在 result() 时约分一次。
+// 各项都在 int64 范围内时使用机器字运算，溢出后切换到延迟化简的 BigInt 分数。
+class RationalAccumulator {
+private:
+    long long num;
+    long long den;
+    bool isSmall;
+    Fraction big; // 溢出后使用，处于延迟化简模式
+
+    void promote();
+    void addTerm(const Fraction& a, const Fraction& b, bool negate);
+
+public:
+    RationalAccumulator();
+    explicit RationalAccumulator(const Fraction& init);
+
+    void reset();
+    RationalAccumulator& add(const Fraction& x);
+    RationalAccumulator& sub(const Fraction& x);
+    RationalAccumulator& fma(const Fraction& a, const Fraction& b); // 累加 a*b
+    RationalAccumulator& fms(const Fraction& a, const Fraction& b); // 累减 a*b
+    Fraction result() const;
+};
+
 // 新增：数学函数
 Fraction pow(const Fraction& base, long long exp);
 Fraction sqrt(const Fraction& f);
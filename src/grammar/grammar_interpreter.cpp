@@ -61,6 +61,8 @@ Variable Interpreter::execute(const std::unique_ptr<AstNode>& node) {
             
             return Variable(Result(delegationMessageStr));
         }
+        case AstNodeType::STRING_LITERAL:
+            throw std::runtime_error("字符串只能作为函数的选项参数使用");
         default:
             throw std::runtime_error("未知的节点类型");
     }
@@ -72,9 +74,24 @@ const std::unordered_map<std::string, Variable>& Interpreter::getVariables() con
 
 // 新增：实现 getVariablesNonConst
 std::unordered_map<std::string, Variable>& Interpreter::getVariablesNonConst() {
+    factorizationCache.clear(); // 调用方可能修改任意变量
     return variables;
 }
 
+std::shared_ptr<const Factorization> Interpreter::factorizationFor(const std::unique_ptr<AstNode>& argNode, const Variable& value) {
+    // 显示步骤时需要完整的消元过程；选择高斯引擎时也保持原有的计算方式
+    if (showSteps || MatrixOperations::getEliminationMode() != EliminationMode::BAREISS ||
+        value.type != VariableType::MATRIX || !argNode || argNode->type != AstNodeType::VARIABLE) {
+        return nullptr;
+    }
+    const std::string& name = static_cast<const VariableNode*>(argNode.get())->name;
+    auto it = factorizationCache.find(name);
+    if (it == factorizationCache.end()) {
+        it = factorizationCache.emplace(name, std::make_shared<const Factorization>(value.matrixValue)).first;
+    }
+    return it->second;
+}
+
 void Interpreter::setShowSteps(bool show) {
     showSteps = show;
 }
@@ -87,6 +104,10 @@ const OperationHistory& Interpreter::getCurrentOpHistory() const {
     return currentOpHistory_;
 }
 
+StepStream& Interpreter::getStepStream() {
+    return currentOpHistory_;
+}
+
 const ExpansionHistory& Interpreter::getCurrentExpHistory() const {
     return currentExpHistory_;
 }
@@ -99,6 +120,7 @@ void Interpreter::clearCurrentHistories() {
 // 新增：实现 clearVariables 方法
 void Interpreter::clearVariables() {
     variables.clear();
+    factorizationCache.clear();
     LOG_INFO("所有变量已被清除。");
 }
 
@@ -109,6 +131,7 @@ void Interpreter::deleteVariable(const std::string& name) {
         throw std::runtime_error("无法删除变量: 变量 '" + name + "' 未定义。");
     }
     variables.erase(it);
+    factorizationCache.erase(name);
     LOG_INFO("变量 '" + name + "' 已被删除。");
 }
 
@@ -132,6 +155,7 @@ void Interpreter::renameVariable(const std::string& oldName, const std::string&
     // 复制变量到新名称，然后删除旧名称
     variables[newName] = old_it->second;
     variables.erase(old_it);
+    factorizationCache.erase(oldName);
     LOG_INFO("变量 '" + oldName + "' 已重命名为 '" + newName + "'。");
 }
 
@@ -204,6 +228,27 @@ Variable Interpreter::executeFunctionCall(const FunctionCallNode* node) {
         }
     }
 
+    // 新增：det(A, "method") 指定行列式的计算方法
+    if (funcNameLower == "det" && node->arguments.size() == 2 &&
+        node->arguments[1]->type == AstNodeType::STRING_LITERAL) {
+        std::string method = static_cast<const StringLiteralNode*>(node->arguments[1].get())->value;
+        std::transform(method.begin(), method.end(), method.begin(),
+                       [](unsigned char c){ return std::tolower(c); });
+        Variable matrixArg = execute(node->arguments[0]);
+        if (matrixArg.type != VariableType::MATRIX) {
+            throw std::runtime_error("det函数需要一个矩阵参数");
+        }
+        if (method == "modular") {
+            return Variable(MatrixOperations::determinantModular(matrixArg.matrixValue));
+        } else if (method == "gauss") {
+            NullOperationHistory history;
+            return Variable(MatrixOperations::determinant(matrixArg.matrixValue, history));
+        } else if (method == "expansion") {
+            return Variable(MatrixOperations::determinantByExpansion(matrixArg.matrixValue));
+        }
+        throw std::runtime_error("未知的行列式计算方法: " + method + "（可选: modular, gauss, expansion）");
+    }
+
     // 获取参数
     std::vector<Variable> args;
     for (const auto& argNode : node->arguments) {
@@ -247,6 +292,9 @@ Variable Interpreter::executeFunctionCall(const FunctionCallNode* node) {
         if (args.size() != 1 || args[0].type != VariableType::MATRIX) {
             throw std::runtime_error("inverse函数需要一个矩阵参数");
         }
+        if (auto factors = factorizationFor(node->arguments[0], args[0])) {
+            return Variable(factors->inverse());
+        }
         return Variable(MatrixOperations::inverse(args[0].matrixValue));
     } else if (funcNameLower == "inverse_gauss") { // 无历史记录版本
         if (args.size() != 1 || args[0].type != VariableType::MATRIX) {
@@ -257,6 +305,9 @@ Variable Interpreter::executeFunctionCall(const FunctionCallNode* node) {
         if (args.size() != 1 || args[0].type != VariableType::MATRIX) {
             throw std::runtime_error("det函数需要一个矩阵参数");
         }
+        if (auto factors = factorizationFor(node->arguments[0], args[0])) {
+            return Variable(factors->det());
+        }
         return Variable(MatrixOperations::determinant(args[0].matrixValue));
     } else if (funcNameLower == "det_expansion") { // 无历史记录版本
         if (args.size() != 1 || args[0].type != VariableType::MATRIX) {
@@ -267,6 +318,9 @@ Variable Interpreter::executeFunctionCall(const FunctionCallNode* node) {
         if (args.size() != 1 || args[0].type != VariableType::MATRIX) {
             throw std::runtime_error("rank函数需要一个矩阵参数");
         }
+        if (auto factors = factorizationFor(node->arguments[0], args[0])) {
+            return Variable(Fraction(factors->rank()));
+        }
         return Variable(Fraction(MatrixOperations::rank(args[0].matrixValue)));
     } else if (funcNameLower == "ref") { // 无历史记录版本
         if (args.size() != 1 || args[0].type != VariableType::MATRIX) {
@@ -355,6 +409,21 @@ Variable Interpreter::executeFunctionCall(const FunctionCallNode* node) {
         }
         return Variable(SimilarMatrixOperations::createDiagonalMatrix(diagElements));
     } else if (funcNameLower == "solveq") {  // 新增：方程组求解函数
+        // 新增：系数矩阵是变量时复用其缓存的分解，只做前代/回代
+        if (args.size() == 1 || (args.size() == 2 && (args[1].type == VariableType::MATRIX || args[1].type == VariableType::VECTOR))) {
+            if (auto factors = factorizationFor(node->arguments[0], args[0])) {
+                Matrix b(args[0].matrixValue.rowCount(), 1); // 齐次方程组取零向量
+                if (args.size() == 2 && args[1].type == VariableType::MATRIX) {
+                    b = args[1].matrixValue;
+                } else if (args.size() == 2) {
+                    b = Matrix(args[1].vectorValue.size(), 1);
+                    for (size_t i = 0; i < args[1].vectorValue.size(); ++i) {
+                        b.at(i, 0) = args[1].vectorValue.at(i);
+                    }
+                }
+                return Variable(EquationSolver::solve(*factors, b));
+            }
+        }
         if (args.size() == 1 && args[0].type == VariableType::MATRIX) {
             // 齐次方程组 Ax = 0
             if (showSteps) {
@@ -456,6 +525,7 @@ Variable Interpreter::executeFunctionCall(const FunctionCallNode* node) {
 Variable Interpreter::executeAssignment(const AssignmentNode* node) {
     Variable value = execute(node->expression);
     variables[node->variableName] = value;
+    factorizationCache.erase(node->variableName);
     return value;
 }
 
@@ -13,6 +13,7 @@
 #include "../operation_step.h"
 #include "../determinant_expansion.h"
 #include "../equationset.h"  // 新增：包含方程组求解头文件
+#include "../factorization.h"
 
 // 变量类型
 enum class VariableType {
@@ -51,9 +52,14 @@ class Interpreter {
 private:
     std::unordered_map<std::string, Variable> variables;
     bool showSteps;
-    OperationHistory currentOpHistory_;
+    StepStream currentOpHistory_; // 新增：改为步骤流，TUI 可在计算进行时浏览步骤
     ExpansionHistory currentExpHistory_;
 
+    // 新增：按变量名缓存矩阵变量的 PLU 分解，变量被赋值、编辑、删除时失效
+    std::unordered_map<std::string, std::shared_ptr<const Factorization>> factorizationCache;
+    // 参数是矩阵变量时返回其分解（必要时计算并缓存），否则返回空指针
+    std::shared_ptr<const Factorization> factorizationFor(const std::unique_ptr<AstNode>& argNode, const Variable& value);
+
     // 新增：导出和导入的辅助方法
     std::string serializeVariable(const std::string& name, const Variable& var) const;
     std::pair<std::string, Variable> deserializeLine(const std::string& line) const;
@@ -83,6 +89,7 @@ public:
     
     // 新增：获取当前操作历史
     const OperationHistory& getCurrentOpHistory() const;
+    StepStream& getStepStream(); // 新增：供 TUI 以流式方式拉取步骤
     
     // 新增：获取当前展开历史
     const ExpansionHistory& getCurrentExpHistory() const;
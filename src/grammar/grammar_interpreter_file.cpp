@@ -330,6 +330,7 @@ std::pair<std::string, std::vector<std::string>> Interpreter::importVariables(co
             {
                 auto pair = deserializeLine(line);
                 variables[pair.first] = pair.second;
+                factorizationCache.erase(pair.first);
             }
             catch (const std::exception &e)
             {
@@ -171,6 +171,11 @@ std::unique_ptr<AstNode> Parser::primary() {
         return std::make_unique<VariableNode>(name);
     }
     
+    // 新增：处理字符串字面量（函数选项）
+    if (match(TokenType::STRING)) {
+        return std::make_unique<StringLiteralNode>(previous().value);
+    }
+
     // 处理整数和分数
     if (match(TokenType::INTEGER) || match(TokenType::FRACTION)) {
         std::string value = previous().value;
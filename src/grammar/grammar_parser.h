@@ -14,7 +14,8 @@ enum class AstNodeType {
     FUNCTION_CALL,  // 函数调用
     ASSIGNMENT,     // 赋值语句
     COMMAND,        // 系统命令
-    ALGEBRAIC_EXPRESSION // 新增：代数表达式，作为某些函数的特殊参数
+    ALGEBRAIC_EXPRESSION, // 新增：代数表达式，作为某些函数的特殊参数
+    STRING_LITERAL  // 新增：字符串字面量，作为某些函数的选项参数
 };
 
 // 抽象语法树节点
@@ -90,6 +91,15 @@ public:
         : AstNode(AstNodeType::ALGEBRAIC_EXPRESSION), expression(expr) {}
 };
 
+// 新增：字符串字面量节点
+class StringLiteralNode : public AstNode {
+public:
+    std::string value;
+
+    StringLiteralNode(const std::string& value)
+        : AstNode(AstNodeType::STRING_LITERAL), value(value) {}
+};
+
 // 语法解析器
 class Parser {
 private:
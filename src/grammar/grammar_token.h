@@ -9,6 +9,7 @@ enum class TokenType {
     IDENTIFIER,     // 变量名、函数名
     INTEGER,        // 整数
     FRACTION,       // 分数
+    STRING,         // 双引号字符串，用作函数的选项参数 (新增)
     
     // 运算符
     PLUS,           // +
@@ -125,6 +125,20 @@ Token Tokenizer::nextToken() {
             return number();
         }
         
+        // 新增：处理双引号字符串
+        if (c == '"') {
+            size_t start = position;
+            while (!isAtEnd() && peek() != '"') {
+                advance();
+            }
+            if (isAtEnd()) {
+                return Token(TokenType::UNKNOWN, input.substr(start - 1));
+            }
+            std::string text = input.substr(start, position - start);
+            advance(); // 消费结尾的 '"'
+            return Token(TokenType::STRING, text);
+        }
+
         // 处理运算符和分隔符
         switch (c) {
             case '+': return Token(TokenType::PLUS, "+");
@@ -0,0 +1,360 @@
+#include "integer_factorization.h"
+#include "cancellation.h"
+#include <algorithm>
+#include <list>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <boost/multiprecision/integer.hpp>
+
+namespace {
+
+// 拆分一个合数时 Pollard-rho 的总迭代预算（约可找出 2^40 以内的素因子，大整数运算下耗时约 1 秒），
+// 以及 f 的轨道在模 n 下整体成环时换常数重试的次数。预算耗尽说明因子太大，换常数也无济于事
+const uint64_t RHO_ITERATION_BUDGET = 1ULL << 20;
+const int RHO_ATTEMPTS = 6;
+// Brent 变体中累乘差值后才求一次 gcd 的批大小
+const uint64_t RHO_BATCH = 128;
+
+// 机器字版本只用于 n < 2^62，y^2 + c 不会溢出；n < 2^127 时用定长 256 位整数，
+// 乘积不会溢出且省去动态分配，比 BigInt 快一倍左右
+const uint64_t WORD_LIMIT = 1ULL << 62;
+const unsigned FIXED_BITS = 127;
+
+using FixedInt = boost::multiprecision::uint256_t;
+
+// Brent 改进的 Pollard-rho：f(y) = y^2 + c，按 2 的幂扩大步长检测循环，批量累乘差值以减少 gcd 次数。
+// 找到非平凡因子时写入 divisor 并返回 true；budget 为剩余迭代次数，随迭代扣减
+template <typename Int, typename MulMod, typename Gcd>
+bool brentRho(const Int& n, const Int& c, MulMod mulmod, Gcd gcd, Int& divisor, uint64_t& budget) {
+    auto f = [&](const Int& y) {
+        Int r = mulmod(y, y) + c;
+        return r >= n ? Int(r - n) : r;
+    };
+    auto diff = [](const Int& a, const Int& b) { return a > b ? Int(a - b) : Int(b - a); };
+
+    Int y = 2, x = 2, ys = 2, q = 1, g = 1;
+    for (uint64_t r = 1; g == 1; r *= 2) {
+        Cancellation::checkpoint();
+        x = y;
+        for (uint64_t i = 0; i < r; ++i) {
+            y = f(y);
+        }
+        for (uint64_t k = 0; k < r && g == 1; k += RHO_BATCH) {
+            ys = y;
+            for (uint64_t i = 0; i < std::min(RHO_BATCH, r - k); ++i) {
+                y = f(y);
+                q = mulmod(q, diff(x, y));
+            }
+            g = gcd(q, n);
+        }
+        if (g == 1 && budget <= 2 * r) {
+            budget = 0;
+            return false;
+        }
+        budget -= 2 * r;
+    }
+    if (g == n) {
+        // 批量累乘越过了因子，逐步回退找出它
+        do {
+            ys = f(ys);
+            g = gcd(diff(x, ys), n);
+        } while (g == 1);
+    }
+    if (g == n) {
+        return false;
+    }
+    divisor = g;
+    return true;
+}
+
+bool pollardRho(const BigInt& n, BigInt& divisor) {
+    uint64_t budget = RHO_ITERATION_BUDGET;
+    for (int attempt = 1; attempt <= RHO_ATTEMPTS && budget > 0; ++attempt) {
+        if (n < WORD_LIMIT) {
+            const uint64_t m = n.convert_to<uint64_t>();
+            uint64_t d = 0;
+            auto mulmod = [m](uint64_t a, uint64_t b) {
+                return static_cast<uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+            };
+            auto gcd = [](uint64_t a, uint64_t b) { return std::gcd(a, b); };
+            if (brentRho<uint64_t>(m, static_cast<uint64_t>(attempt), mulmod, gcd, d, budget)) {
+                divisor = d;
+                return true;
+            }
+        } else if (boost::multiprecision::msb(n) < FIXED_BITS) {
+            const FixedInt m = static_cast<FixedInt>(n);
+            FixedInt d = 0;
+            auto mulmod = [&m](const FixedInt& a, const FixedInt& b) { return FixedInt(a * b % m); };
+            auto gcd = [](const FixedInt& a, const FixedInt& b) { return FixedInt(boost::multiprecision::gcd(a, b)); };
+            if (brentRho<FixedInt>(m, FixedInt(attempt), mulmod, gcd, d, budget)) {
+                divisor = static_cast<BigInt>(d);
+                return true;
+            }
+        } else {
+            auto mulmod = [&n](const BigInt& a, const BigInt& b) { return BigInt(a * b % n); };
+            auto gcd = [](const BigInt& a, const BigInt& b) { return BigInt(boost::multiprecision::gcd(a, b)); };
+            if (brentRho<BigInt>(n, BigInt(attempt), mulmod, gcd, divisor, budget)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// 最近使用的分解结果；只缓存试除不能很快完成的数（超过 SIEVE_LIMIT^2）
+class FactorCache {
+public:
+    bool find(const BigInt& n, IntegerFactorization::Factors& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(n);
+        if (it == index.end()) {
+            return false;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        out = it->second->second;
+        return true;
+    }
+
+    void insert(const BigInt& n, const IntegerFactorization::Factors& factors) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (index.count(n)) {
+            return;
+        }
+        entries.emplace_front(n, factors);
+        index[n] = entries.begin();
+        if (entries.size() > IntegerFactorization::CACHE_CAPACITY) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::list<std::pair<BigInt, IntegerFactorization::Factors>> entries;
+    std::map<BigInt, std::list<std::pair<BigInt, IntegerFactorization::Factors>>::iterator> index;
+};
+
+FactorCache& cache() {
+    static FactorCache instance;
+    return instance;
+}
+
+// 把已确认无小素因子的 m 拆成素数（或拆不开的合数），追加到 out
+void splitLarge(const BigInt& m, std::vector<BigInt>& out) {
+    std::vector<BigInt> pending = {m};
+    while (!pending.empty()) {
+        BigInt x = std::move(pending.back());
+        pending.pop_back();
+        if (IntegerFactorization::isProbablePrime(x)) {
+            out.push_back(x);
+            continue;
+        }
+        // 素数幂会让 rho 在模 p 与模 p^k 下同时成环，先检查完全方幂；
+        // x 没有不超过 SIEVE_LIMIT 的素因子，所以幂次不超过 bits / 16
+        bool perfectPower = false;
+        const unsigned bits = static_cast<unsigned>(boost::multiprecision::msb(x)) + 1;
+        for (unsigned k = 2; k <= bits / 16 && !perfectPower; ++k) {
+            BigInt root = IntegerFactorization::integerRoot(x, k);
+            if (boost::multiprecision::pow(root, k) == x) {
+                for (unsigned i = 0; i < k; ++i) {
+                    pending.push_back(root);
+                }
+                perfectPower = true;
+            }
+        }
+        if (perfectPower) {
+            continue;
+        }
+        BigInt d;
+        if (pollardRho(x, d)) {
+            pending.push_back(d);
+            pending.push_back(x / d);
+        } else {
+            out.push_back(x); // 拆不开的合数
+        }
+    }
+}
+
+} // namespace
+
+const std::vector<uint32_t>& IntegerFactorization::smallPrimes() {
+    static const std::vector<uint32_t> primes = [] {
+        std::vector<bool> composite(SIEVE_LIMIT + 1, false);
+        std::vector<uint32_t> result;
+        for (uint32_t i = 2; i <= SIEVE_LIMIT; ++i) {
+            if (composite[i]) {
+                continue;
+            }
+            result.push_back(i);
+            for (uint64_t j = static_cast<uint64_t>(i) * i; j <= SIEVE_LIMIT; j += i) {
+                composite[j] = true;
+            }
+        }
+        return result;
+    }();
+    return primes;
+}
+
+bool IntegerFactorization::isProbablePrime(const BigInt& n) {
+    if (n < 2) {
+        return false;
+    }
+    const std::vector<uint32_t>& primes = smallPrimes();
+    if (n <= SIEVE_LIMIT) {
+        return std::binary_search(primes.begin(), primes.end(), n.convert_to<uint32_t>());
+    }
+    // 先用前几十个小素数试除，绝大多数合数在这里就被排除
+    for (size_t i = 0; i < 64; ++i) {
+        if (n % primes[i] == 0) {
+            return false;
+        }
+    }
+
+    BigInt d = n - 1;
+    unsigned s = 0;
+    while (!boost::multiprecision::bit_test(d, 0)) {
+        d >>= 1;
+        ++s;
+    }
+    const BigInt nMinusOne = n - 1;
+    for (size_t i = 0; i < 20; ++i) {
+        BigInt x = boost::multiprecision::powm(BigInt(primes[i]), d, n);
+        if (x == 1 || x == nMinusOne) {
+            continue;
+        }
+        bool composite = true;
+        for (unsigned r = 1; r < s; ++r) {
+            x = x * x % n;
+            if (x == nMinusOne) {
+                composite = false;
+                break;
+            }
+        }
+        if (composite) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BigInt IntegerFactorization::integerRoot(const BigInt& n, unsigned k) {
+    if (k == 0) {
+        throw std::invalid_argument("Cannot compute 0th root.");
+    }
+    BigInt m = abs(n);
+    if (m < 2 || k == 1) {
+        return m;
+    }
+    const unsigned bits = static_cast<unsigned>(boost::multiprecision::msb(m)) + 1;
+    if (k >= bits) {
+        return 1; // 2^bits > m，根小于 2
+    }
+    // 初值 2^ceil(bits/k) 不小于真值，牛顿迭代单调下降到 floor
+    BigInt x = BigInt(1) << ((bits + k - 1) / k);
+    while (true) {
+        BigInt next = (x * (k - 1) + m / boost::multiprecision::pow(x, k - 1)) / k;
+        if (next >= x) {
+            return x;
+        }
+        x = std::move(next);
+    }
+}
+
+bool IntegerFactorization::isPerfectPower(const BigInt& n, unsigned k) {
+    if (k == 0) {
+        throw std::invalid_argument("Cannot compute 0th root.");
+    }
+    BigInt m = abs(n);
+    if (m < 2 || k == 1) {
+        return true;
+    }
+    // 小素因子的重数必须是 k 的倍数
+    const std::vector<uint32_t>& primes = smallPrimes();
+    for (size_t i = 0; i < 25 && m >= primes[i]; ++i) {
+        unsigned e = 0;
+        while (m % primes[i] == 0) {
+            m /= primes[i];
+            ++e;
+        }
+        if (e % k != 0) {
+            return false;
+        }
+    }
+    return boost::multiprecision::pow(integerRoot(m, k), k) == m;
+}
+
+IntegerFactorization::Factors IntegerFactorization::factor(const BigInt& n) {
+    BigInt m = abs(n);
+    if (m == 0) {
+        throw std::invalid_argument("Cannot factor zero.");
+    }
+    Factors result;
+    if (m == 1) {
+        return result;
+    }
+    const bool cacheable = m > BigInt(SIEVE_LIMIT) * SIEVE_LIMIT;
+    if (cacheable && cache().find(m, result)) {
+        return result;
+    }
+    const BigInt original = m;
+
+    // 小素数试除
+    unsigned polls = 0;
+    for (uint32_t p : smallPrimes()) {
+        if (BigInt(p) * p > m) {
+            break;
+        }
+        if ((++polls & 0xFFF) == 0) {
+            Cancellation::checkpoint();
+        }
+        if (m % p == 0) {
+            unsigned e = 0;
+            do {
+                m /= p;
+                ++e;
+            } while (m % p == 0);
+            result.emplace_back(BigInt(p), e);
+        }
+    }
+
+    if (m > 1) {
+        std::vector<BigInt> large;
+        if (m <= BigInt(SIEVE_LIMIT) * SIEVE_LIMIT) {
+            large.push_back(m); // 试除到 sqrt(m) 仍未整除，m 是素数
+        } else {
+            splitLarge(m, large);
+        }
+        std::sort(large.begin(), large.end());
+        for (size_t i = 0; i < large.size();) {
+            size_t j = i;
+            while (j < large.size() && large[j] == large[i]) {
+                ++j;
+            }
+            result.emplace_back(large[i], static_cast<unsigned>(j - i));
+            i = j;
+        }
+    }
+
+    if (cacheable) {
+        cache().insert(original, result);
+    }
+    return result;
+}
+
+std::vector<BigInt> IntegerFactorization::divisors(const BigInt& n) {
+    std::vector<BigInt> result = {BigInt(1)};
+    for (const auto& pe : factor(n)) {
+        const size_t count = result.size();
+        BigInt power = 1;
+        for (unsigned e = 1; e <= pe.second; ++e) {
+            power *= pe.first;
+            for (size_t i = 0; i < count; ++i) {
+                result.push_back(result[i] * power);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
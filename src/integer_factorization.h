@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "fraction.h"
+
+// 全项目共用的整数分解服务：小素数筛试除 + Miller-Rabin 素性测试 + Pollard-rho（Brent 变体），
+// 分解结果放入按最近使用淘汰（LRU）的缓存。根式化简、因数枚举、完全方幂判断都经由这里，
+// 20 位以上的整数也不会像逐个试除那样卡住。
+class IntegerFactorization {
+public:
+    // 素因子及其重数，按素因子递增排列
+    using Factors = std::vector<std::pair<BigInt, unsigned>>;
+
+    // 分解 |n|，n 为 0 时抛出 std::invalid_argument，|n| = 1 时返回空。
+    // Pollard-rho 在迭代上限内仍拆不开的合数会原样作为一项出现（可用 isProbablePrime 区分）
+    static Factors factor(const BigInt& n);
+
+    // |n| 的全部正因数，按升序排列
+    static std::vector<BigInt> divisors(const BigInt& n);
+
+    // 素性测试：取前 20 个素数为底的 Miller-Rabin，n < 3.3 * 10^24 时是确定性的
+    static bool isProbablePrime(const BigInt& n);
+
+    // floor(|n|^(1/k))，牛顿迭代，k 须为正
+    static BigInt integerRoot(const BigInt& n, unsigned k);
+
+    // |n| 是否为某个整数的 k 次方；先用小素数的重数快速排除，再用 integerRoot 验证
+    static bool isPerfectPower(const BigInt& n, unsigned k);
+
+    // 不超过 SIEVE_LIMIT 的全部素数（埃氏筛，首次使用时生成）
+    static const std::vector<uint32_t>& smallPrimes();
+
+    static constexpr uint32_t SIEVE_LIMIT = 1u << 16;
+    static constexpr size_t CACHE_CAPACITY = 256;
+};
@@ -4,6 +4,7 @@
 #include "utils/logger.h"
 #include "tui/startup_screen.h" // 新增：包含启动界面头文件
 #include "tui/tui_terminal.h"   // 新增：包含Terminal以便在main中初始化
+#include "cancellation.h"
 #include <filesystem>           // 新增：包含filesystem以获取当前路径
 
 #ifdef _WIN32
@@ -21,6 +22,12 @@ std::mutex g_export_mutex;
 #ifdef _WIN32
 BOOL WINAPI CtrlHandler(DWORD fdwCtrlType)
 {
+    // 新增：计算进行中时 Ctrl-C 只取消计算，不退出程序
+    if (fdwCtrlType == CTRL_C_EVENT && Cancellation::running())
+    {
+        Cancellation::request();
+        return TRUE;
+    }
     if (!g_work_env_file_path.empty() && g_app_ptr)
     {
         std::lock_guard<std::mutex> lock(g_export_mutex);
@@ -37,6 +44,12 @@ BOOL WINAPI CtrlHandler(DWORD fdwCtrlType)
 #include <unistd.h>
 void signal_handler(int signo)
 {
+    // 新增：计算进行中时 Ctrl-C 只取消计算，不退出程序
+    if (signo == SIGINT && Cancellation::running())
+    {
+        Cancellation::request();
+        return;
+    }
     if (!g_work_env_file_path.empty() && g_app_ptr)
     {
         std::lock_guard<std::mutex> lock(g_export_mutex);
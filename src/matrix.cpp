@@ -1,22 +1,43 @@
 #include "matrix.h"
 #include "determinant_expansion.h"
+#include "task_scheduler.h"
+#include "cancellation.h"
+#include "progress.h"
 #include <iomanip>
 #include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
 #include <boost/lexical_cast.hpp> // 新增：用于 BigInt 到字符串的转换
 
-Matrix::Matrix(size_t r, size_t c) : rows(r), cols(c), data(r, std::vector<Fraction>(c)) {}
+Matrix::Matrix(size_t r, size_t c) : rows(r), cols(c), data(r * c) {}
 
 Matrix::Matrix(const std::vector<std::vector<Fraction>>& d)
-    : rows(d.size()), cols(d.empty() ? 0 : d[0].size()), data(d) {}
+    : rows(d.size()), cols(d.empty() ? 0 : d[0].size()) {
+    data.reserve(rows * cols);
+    for (const auto& row : d) {
+        if (row.size() != cols) {
+            throw std::invalid_argument("Matrix rows must have the same number of columns.");
+        }
+        data.insert(data.end(), row.begin(), row.end());
+    }
+}
 
 size_t Matrix::rowCount() const { return rows; }
 size_t Matrix::colCount() const { return cols; }
 
-Fraction& Matrix::at(size_t r, size_t c) { return data[r][c]; }
-const Fraction& Matrix::at(size_t r, size_t c) const { return data[r][c]; }
+void Matrix::swapRows(size_t r1, size_t r2) {
+    if (r1 >= rows || r2 >= rows) {
+        throw std::out_of_range("Row index out of range in swapRows");
+    }
+    if (r1 != r2) {
+        std::swap_ranges(rowData(r1), rowData(r1) + cols, rowData(r2));
+    }
+}
 
 void Matrix::input(std::istream& is) {
     for (size_t i = 0; i < rows; ++i)
@@ -34,7 +55,7 @@ void Matrix::input(std::istream& is) {
                 try {
                     BigInt num(num_str);
                     BigInt den(den_str);
-                    data[i][j] = Fraction(num, den);
+                    at(i, j) = Fraction(num, den);
                 } catch (const std::exception& e) {
                     throw std::invalid_argument("Invalid fraction format: " + input_str);
                 }
@@ -42,7 +63,7 @@ void Matrix::input(std::istream& is) {
                 // 整数形式输入
                 try {
                     BigInt num(input_str);
-                    data[i][j] = Fraction(num);
+                    at(i, j) = Fraction(num);
                 } catch (const std::exception& e) {
                     throw std::invalid_argument("Invalid number format: " + input_str);
                 }
@@ -57,7 +78,7 @@ void Matrix::print(std::ostream& os) const {
         os << "| ";
         for (size_t j = 0; j < cols; ++j) {
             std::ostringstream oss;
-            oss << data[i][j];
+            oss << at(i, j);
             std::string s = oss.str();
 
             int len = s.length();
@@ -87,7 +108,7 @@ Matrix Matrix::operator+(const Matrix& rhs) const {
     Matrix res(rows, cols);
     for (size_t i = 0; i < rows; ++i)
         for (size_t j = 0; j < cols; ++j)
-            res.data[i][j] = data[i][j] + rhs.data[i][j];
+            res.at(i, j) = at(i, j) + rhs.at(i, j);
     return res;
 }
 
@@ -95,7 +116,7 @@ Matrix Matrix::operator-(const Matrix& rhs) const {
     Matrix res(rows, cols);
     for (size_t i = 0; i < rows; ++i)
         for (size_t j = 0; j < cols; ++j)
-            res.data[i][j] = data[i][j] - rhs.data[i][j];
+            res.at(i, j) = at(i, j) - rhs.at(i, j);
     return res;
 }
 
@@ -103,7 +124,7 @@ Matrix Matrix::operator*(const Fraction& k) const {
     Matrix res(rows, cols);
     for (size_t i = 0; i < rows; ++i)
         for (size_t j = 0; j < cols; ++j)
-            res.data[i][j] = data[i][j] * k;
+            res.at(i, j) = at(i, j) * k;
     return res;
 }
 
@@ -113,13 +134,54 @@ Matrix Matrix::operator*(const Matrix& rhs) const {
     }
     
     Matrix result(rows, rhs.cols);
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < rhs.cols; ++j) {
-            Fraction sum;
-            for (size_t k = 0; k < cols; ++k) {
-                sum += data[i][k] * rhs.data[k][j];
+    const size_t n = rhs.cols;
+    const size_t rowTiles = (rows + MUL_TILE - 1) / MUL_TILE;
+    const size_t colTiles = (n + MUL_TILE - 1) / MUL_TILE;
+    const size_t tileCount = rowTiles * colTiles;
+
+    // 输出按 MUL_TILE x MUL_TILE 分块分配给线程，每块在线程自己的累加器上求和；
+    // k 方向再按 MUL_TILE 分段，使 A 的行段和 B 的行段在一段内重复命中缓存。
+    // 每个元素都是精确的有理数求和，结果与串行计算完全相同
+    auto multiplyTile = [&](size_t t) {
+        const size_t i0 = t / colTiles * MUL_TILE;
+        const size_t j0 = t % colTiles * MUL_TILE;
+        const size_t i1 = std::min(i0 + MUL_TILE, rows);
+        const size_t j1 = std::min(j0 + MUL_TILE, n);
+        const size_t width = j1 - j0;
+
+        // 在公共分母上累加，结束时统一化简
+        std::vector<RationalAccumulator> sums((i1 - i0) * width);
+        for (size_t k0 = 0; k0 < cols; k0 += MUL_TILE) {
+            const size_t k1 = std::min(k0 + MUL_TILE, cols);
+            for (size_t i = i0; i < i1; ++i) {
+                const Fraction* a = rowData(i);
+                RationalAccumulator* acc = sums.data() + (i - i0) * width;
+                for (size_t k = k0; k < k1; ++k) {
+                    if (a[k] == Fraction(0)) {
+                        continue;
+                    }
+                    const Fraction* b = rhs.rowData(k) + j0;
+                    for (size_t j = 0; j < width; ++j) {
+                        acc[j].fma(a[k], b[j]);
+                    }
+                }
             }
-            result.data[i][j] = sum;
+        }
+        for (size_t i = i0; i < i1; ++i) {
+            Fraction* out = result.rowData(i) + j0;
+            const RationalAccumulator* acc = sums.data() + (i - i0) * width;
+            for (size_t j = 0; j < width; ++j) {
+                out[j] = acc[j].result();
+            }
+        }
+    };
+
+    // 规模太小时线程调度的开销比计算本身还大，只在乘加次数足够多时并行
+    if (tileCount > 1 && rows * n * cols >= MUL_PARALLEL_THRESHOLD) {
+        TaskScheduler::parallelFor(0, tileCount, multiplyTile);
+    } else {
+        for (size_t t = 0; t < tileCount; ++t) {
+            multiplyTile(t);
         }
     }
     return result;
@@ -127,9 +189,11 @@ Matrix Matrix::operator*(const Matrix& rhs) const {
 
 Matrix Matrix::transpose() const {
     Matrix res(cols, rows);
-    for (size_t i = 0; i < rows; ++i)
+    for (size_t i = 0; i < rows; ++i) {
+        const Fraction* src = rowData(i);
         for (size_t j = 0; j < cols; ++j)
-            res.data[j][i] = data[i][j];
+            res.data[j * rows + i] = src[j];
+    }
     return res;
 }
 
@@ -140,21 +204,229 @@ Matrix Matrix::getSubMatrix(size_t excludeRow, size_t excludeCol) const {
     }
     
     Matrix result(rows - 1, cols - 1);
-    size_t r = 0;
+    Fraction* dst = result.data.data();
     for (size_t i = 0; i < rows; ++i) {
         if (i == excludeRow) continue;
+        const Fraction* src = rowData(i);
+        dst = std::copy(src, src + excludeCol, dst);
+        dst = std::copy(src + excludeCol + 1, src + cols, dst);
+    }
+    return result;
+}
+
+// 在视图上查找零元素最多的行或列，规则与 findOptimalExpansionIndex 相同
+static std::pair<bool, size_t> findOptimalExpansionLine(const MatrixView& view) {
+    size_t n = view.rowCount();
+    size_t bestRow = 0, bestCol = 0;
+    size_t bestRowZeros = 0, bestColZeros = 0;
+    for (size_t i = 0; i < n; ++i) {
+        size_t rowZeros = 0, colZeros = 0;
+        for (size_t j = 0; j < n; ++j) {
+            if (view.at(i, j).getNumerator() == 0) rowZeros++;
+            if (view.at(j, i).getNumerator() == 0) colZeros++;
+        }
+        if (i == 0 || rowZeros > bestRowZeros) { bestRowZeros = rowZeros; bestRow = i; }
+        if (i == 0 || colZeros > bestColZeros) { bestColZeros = colZeros; bestCol = i; }
+    }
+    if (bestRowZeros >= bestColZeros) {
+        return {true, bestRow};
+    }
+    return {false, bestCol};
+}
+
+// 在子式视图上递归按行列展开，子式通过工作区中的下标映射表示，不分配新的矩阵
+static Fraction determinantOfView(const MatrixView& view, MatrixView::Workspace& ws) {
+    size_t n = view.rowCount();
+    
+    // 递归的基本情况 - 1x1 矩阵
+    if (n == 1) {
+        return view.at(0, 0);
+    }
+    
+    // 递归的基本情况 - 2x2 矩阵
+    if (n == 2) {
+        RationalAccumulator det2;
+        det2.fma(view.at(0, 0), view.at(1, 1)).fms(view.at(0, 1), view.at(1, 0));
+        return det2.result();
+    }
+    
+    Cancellation::checkpoint();
+
+    // 选择最优展开行/列
+    auto [expandByRow, expandIndex] = findOptimalExpansionLine(view);
+    
+    RationalAccumulator result;
+    for (size_t k = 0; k < n; ++k) {
+        size_t i = expandByRow ? expandIndex : k;
+        size_t j = expandByRow ? k : expandIndex;
+        const Fraction& element = view.at(i, j);
         
-        size_t c = 0;
-        for (size_t j = 0; j < cols; ++j) {
-            if (j == excludeCol) continue;
-            result.at(r, c) = data[i][j];
-            ++c;
+        // 如果元素为0，跳过（提高效率）
+        if (element.getNumerator() == 0) {
+            continue;
         }
-        ++r;
+        
+        // 递归计算子式的行列式
+        Fraction subDet = determinantOfView(view.minor(i, j, ws), ws);
+        if ((i + j) % 2 == 0) result.fma(element, subDet);
+        else result.fms(element, subDet);
     }
-    return result;
+    
+    return result.result();
 }
 
+namespace {
+
+// 余子式求值器。64 阶以内以 (行子集, 列子集) 位掩码为键缓存子式：每个子式总是沿其最上面一行展开，
+// 因此同一矩阵的全部展开共享子式，每个子式只计算一次，总代价 O(2^n * n)。
+// 缓存按估算的字节数设上限，超出后继续计算但不再缓存；超过 64 阶时退回视图递归。
+// 阶数较高的子式把各展开项的子式作为任务交给线程池，子任务还会继续分叉；缓存按键分片加锁，
+// 不同线程偶尔会重复计算同一个子式，但结果相同，总和按展开顺序累加，与串行结果一致。
+class MinorEvaluator {
+public:
+    explicit MinorEvaluator(const Matrix& m)
+        : mat(m), n(m.rowCount()), ws(n, n), full(m, n, n, ws) {}
+
+    Fraction determinant() {
+        if (n == 0) return Fraction(1);
+        if (n > MAX_MASK_SIZE) return determinantOfView(full, ws);
+        return memoDeterminant(fullMask(), fullMask());
+    }
+
+    // 去掉第 row 行和第 col 列后的余子式（不含符号）
+    Fraction minor(size_t row, size_t col) {
+        if (n > MAX_MASK_SIZE) return determinantOfView(full.minor(row, col, ws), ws);
+        return memoDeterminant(fullMask() & ~(1ULL << row), fullMask() & ~(1ULL << col));
+    }
+
+private:
+    static const size_t MAX_MASK_SIZE = 64;
+    // 缓存的内存上限（按条目估算）：小分数的条目约 140 字节，约可缓存 48 万个子式
+    static const size_t MAX_CACHE_BYTES = size_t(64) << 20;
+    static const int PARALLEL_MIN_ORDER = 9;   // 低于该阶的子式在当前线程上递归
+    static const size_t MEMO_SHARDS = 16;
+
+    struct MaskPairHash {
+        size_t operator()(const std::pair<uint64_t, uint64_t>& k) const {
+            return std::hash<uint64_t>()(k.first * 0x9E3779B97F4A7C15ULL ^ k.second);
+        }
+    };
+
+    struct MemoShard {
+        std::mutex mutex;
+        std::unordered_map<std::pair<uint64_t, uint64_t>, Fraction, MaskPairHash> entries;
+    };
+
+    const Matrix& mat;
+    size_t n;
+    MatrixView::Workspace ws;
+    MatrixView full;
+    MemoShard memo[MEMO_SHARDS];
+    std::atomic<size_t> memoBytes{0};
+
+    MemoShard& shardFor(const std::pair<uint64_t, uint64_t>& key) {
+        return memo[MaskPairHash()(key) % MEMO_SHARDS];
+    }
+
+    uint64_t fullMask() const { return n == 64 ? ~0ULL : ((1ULL << n) - 1); }
+
+    // BigInt 超出内联存储后在堆上分配的字节数
+    static size_t heapBytes(const BigInt& x) {
+        const size_t limbs = x.backend().size();
+        return limbs > BigInt::backend_type::internal_limb_count ? limbs * sizeof(boost::multiprecision::limb_type) : 0;
+    }
+
+    // 一个缓存条目的估算大小：键值对、哈希表节点的链指针与缓存的哈希值、桶数组中的一个指针，以及分子分母的堆内存
+    static size_t entryBytes(const Fraction& value) {
+        using Node = std::pair<const std::pair<uint64_t, uint64_t>, Fraction>;
+        return sizeof(Node) + 3 * sizeof(void*) + heapBytes(value.getNumerator()) + heapBytes(value.getDenominator());
+    }
+
+    Fraction memoDeterminant(uint64_t rowMask, uint64_t colMask) {
+        int k = __builtin_popcountll(rowMask);
+        if (k == 0) {
+            return Fraction(1);
+        }
+        size_t r = __builtin_ctzll(rowMask);
+        if (k == 1) {
+            return mat.at(r, __builtin_ctzll(colMask));
+        }
+        if (k == 2) {
+            size_t r2 = __builtin_ctzll(rowMask & (rowMask - 1));
+            size_t c1 = __builtin_ctzll(colMask);
+            size_t c2 = __builtin_ctzll(colMask & (colMask - 1));
+            RationalAccumulator det2;
+            det2.fma(mat.at(r, c1), mat.at(r2, c2)).fms(mat.at(r, c2), mat.at(r2, c1));
+            return det2.result();
+        }
+
+        auto key = std::make_pair(rowMask, colMask);
+        MemoShard& shard = shardFor(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end()) {
+                return it->second;
+            }
+        }
+
+        // 每个未命中缓存的子式检查一次取消请求，并计入进度
+        Cancellation::checkpoint();
+        Progress::advance("余子式展开: 已计算子式");
+
+        // 沿子式的第一行展开
+        uint64_t restRows = rowMask & ~(1ULL << r);
+        RationalAccumulator acc;
+        if (k >= PARALLEL_MIN_ORDER && TaskScheduler::threadCount() > 1) {
+            std::vector<Fraction> subs(k);
+            TaskGroup group;
+            size_t pos = 0;
+            for (uint64_t m = colMask; m != 0; m &= m - 1, ++pos) {
+                size_t c = __builtin_ctzll(m);
+                if (mat.at(r, c).getNumerator() != 0) {
+                    group.run([this, &subs, pos, restRows, colMask, c] {
+                        subs[pos] = memoDeterminant(restRows, colMask & ~(1ULL << c));
+                    });
+                }
+            }
+            group.wait();
+            pos = 0;
+            for (uint64_t m = colMask; m != 0; m &= m - 1, ++pos) {
+                const Fraction& element = mat.at(r, __builtin_ctzll(m));
+                if (element.getNumerator() == 0) {
+                    continue;
+                }
+                if (pos % 2 == 0) acc.fma(element, subs[pos]);
+                else acc.fms(element, subs[pos]);
+            }
+        } else {
+            size_t pos = 0;
+            for (uint64_t m = colMask; m != 0; m &= m - 1, ++pos) {
+                size_t c = __builtin_ctzll(m);
+                const Fraction& element = mat.at(r, c);
+                if (element.getNumerator() == 0) {
+                    continue;
+                }
+                Fraction sub = memoDeterminant(restRows, colMask & ~(1ULL << c));
+                if (pos % 2 == 0) acc.fma(element, sub);
+                else acc.fms(element, sub);
+            }
+        }
+
+        Fraction result = acc.result();
+        const size_t bytes = entryBytes(result);
+        if (memoBytes.load(std::memory_order_relaxed) + bytes <= MAX_CACHE_BYTES) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.entries.emplace(key, result).second) {
+                memoBytes.fetch_add(bytes, std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+};
+
+} // namespace
+
 // 计算代数余子式
 Fraction Matrix::cofactor(size_t row, size_t col) const {
     if (row >= rows || col >= cols) {
@@ -166,25 +438,13 @@ Fraction Matrix::cofactor(size_t row, size_t col) const {
     
     // 如果是1x1矩阵，直接返回元素值乘以代数因子
     if (rows == 1 && cols == 1) {
-        return Fraction(sign) * data[0][0];
+        return Fraction(sign) * at(0, 0);
     }
     
-    // 计算余子式（子矩阵的行列式）
-    Matrix subMatrix = getSubMatrix(row, col);
-    
-    // 对于小矩阵，我们可以直接计算行列式
-    Fraction det;
-    if (subMatrix.rows == 1) {
-        det = subMatrix.data[0][0];
-    } else if (subMatrix.rows == 2) {
-        det = subMatrix.data[0][0] * subMatrix.data[1][1] - 
-              subMatrix.data[0][1] * subMatrix.data[1][0];
-    } else {
-        // 对于较大的矩阵，使用现有的行列式计算方法
-        det = subMatrix.determinantByExpansion();
-    }
+    // 计算余子式
+    Fraction det = MinorEvaluator(*this).minor(row, col);
     
-    return Fraction(sign) * det;
+    return sign > 0 ? det : -det;
 }
 
 // 计算代数余子式矩阵
@@ -192,11 +452,17 @@ Matrix Matrix::cofactorMatrix() const {
     if (rows != cols) {
         throw std::invalid_argument("Cofactor matrix can only be calculated for square matrices");
     }
+    if (rows == 1) {
+        return Matrix(std::vector<std::vector<Fraction>>{{cofactor(0, 0)}});
+    }
     
+    // 所有余子式共用同一个子式缓存
+    MinorEvaluator minors(*this);
     Matrix result(rows, cols);
     for (size_t i = 0; i < rows; ++i) {
         for (size_t j = 0; j < cols; ++j) {
-            result.at(i, j) = cofactor(i, j);
+            Fraction det = minors.minor(i, j);
+            result.at(i, j) = ((i + j) % 2 == 0) ? det : -det;
         }
     }
     return result;
@@ -217,7 +483,7 @@ std::pair<bool, size_t> Matrix::findOptimalExpansionIndex() const {
     std::vector<int> rowZeros(rows, 0);
     for (size_t i = 0; i < rows; ++i) {
         for (size_t j = 0; j < cols; ++j) {
-            if (data[i][j] == Fraction(0)) {
+            if (at(i, j) == Fraction(0)) {
                 rowZeros[i]++;
             }
         }
@@ -227,7 +493,7 @@ std::pair<bool, size_t> Matrix::findOptimalExpansionIndex() const {
     std::vector<int> colZeros(cols, 0);
     for (size_t j = 0; j < cols; ++j) {
         for (size_t i = 0; i < rows; ++i) {
-            if (data[i][j] == Fraction(0)) {
+            if (at(i, j) == Fraction(0)) {
                 colZeros[j]++;
             }
         }
@@ -252,81 +518,13 @@ std::pair<bool, size_t> Matrix::findOptimalExpansionIndex() const {
     }
 }
 
-// 更改函数名称，与头文件定义保持一致
-Fraction Matrix::determinantByExpansionRecursive(ExpansionHistory& history, int depth) const {
-    // 实现递归计算行列式的方法
-    // 这里应包含原来的递归实现代码
-    // 但出于简洁考虑，此处使用按行列式展开计算的实现
-    
-    if (rows != cols) {
-        throw std::invalid_argument("Determinant can only be calculated for square matrices");
-    }
-    
-    // 递归的基本情况 - 1x1 矩阵
-    if (rows == 1) {
-        return data[0][0];
-    }
-    
-    // 递归的基本情况 - 2x2 矩阵
-    if (rows == 2) {
-        return data[0][0] * data[1][1] - data[0][1] * data[1][0];
-    }
-    
-    // 选择最优展开行/列
-    auto [expandByRow, expandIndex] = findOptimalExpansionIndex();
-    
-    Fraction result;
-    
-    // 按行展开
-    if (expandByRow) {
-        for (size_t j = 0; j < cols; ++j) {
-            Fraction element = data[expandIndex][j];
-            
-            // 如果元素为0，跳过（提高效率）
-            if (element == Fraction(0)) {
-                continue;
-            }
-            
-            // 计算代数余子式
-            int sign = ((expandIndex + j) % 2 == 0) ? 1 : -1;
-            Matrix subMatrix = getSubMatrix(expandIndex, j);
-            
-            // 递归计算子矩阵的行列式
-            Fraction subDet = subMatrix.determinantByExpansionRecursive(history, depth + 1);
-            result += Fraction(sign) * element * subDet;
-        }
-    }
-    // 按列展开
-    else {
-        for (size_t i = 0; i < rows; ++i) {
-            Fraction element = data[i][expandIndex];
-            
-            // 如果元素为0，跳过（提高效率）
-            if (element == Fraction(0)) {
-                continue;
-            }
-            
-            // 计算代数余子式
-            int sign = ((i + expandIndex) % 2 == 0) ? 1 : -1;
-            Matrix subMatrix = getSubMatrix(i, expandIndex);
-            
-            // 递归计算子矩阵的行列式
-            Fraction subDet = subMatrix.determinantByExpansionRecursive(history, depth + 1);
-            result += Fraction(sign) * element * subDet;
-        }
-    }
-    
-    return result;
-}
-
 // 按行列式展开计算行列式（不带历史记录）
 Fraction Matrix::determinantByExpansion() const {
     if (rows != cols) {
         throw std::invalid_argument("Determinant can only be calculated for square matrices");
     }
     
-    ExpansionHistory dummy;
-    return determinantByExpansion(dummy);
+    return MinorEvaluator(*this).determinant();
 }
 
 // 按行列式展开计算行列式（带历史记录）
@@ -346,7 +544,7 @@ Fraction Matrix::determinantByExpansion(ExpansionHistory& history) const {
     
     // 特殊情况处理
     if (rows == 1) {
-        Fraction result = data[0][0];
+        Fraction result = at(0, 0);
         history.addStep(ExpansionStep(
             ExpansionType::RESULT_STATE,
             "1x1矩阵行列式 = " + boost::lexical_cast<std::string>(result.getNumerator()) + 
@@ -358,10 +556,10 @@ Fraction Matrix::determinantByExpansion(ExpansionHistory& history) const {
     }
     
     if (rows == 2) {
-        Fraction result = data[0][0] * data[1][1] - data[0][1] * data[1][0];
+        Fraction result = at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
         std::stringstream ss2;
-        ss2 << "2x2行列式 = " << data[0][0] << " * " << data[1][1] << " - " 
-           << data[0][1] << " * " << data[1][0] << " = " << result;
+        ss2 << "2x2行列式 = " << at(0, 0) << " * " << at(1, 1) << " - " 
+           << at(0, 1) << " * " << at(1, 0) << " = " << result;
         history.addStep(ExpansionStep(
             ExpansionType::RESULT_STATE,
             ss2.str(),
@@ -383,12 +581,14 @@ Fraction Matrix::determinantByExpansion(ExpansionHistory& history) const {
         expandIndex
     ));
     
+    // 子式的行列式由共享缓存的求值器计算，矩阵快照只用于展示
+    MinorEvaluator minors(*this);
     Fraction result;
     
     // 按行展开
     if (expandByRow) {
         for (size_t j = 0; j < cols; ++j) {
-            Fraction element = data[expandIndex][j];
+            Fraction element = at(expandIndex, j);
             
             // 如果元素为0，跳过（提高效率）
             if (element == Fraction(0)) {
@@ -417,8 +617,8 @@ Fraction Matrix::determinantByExpansion(ExpansionHistory& history) const {
                 expandIndex, j, element
             ));
             
-            // 递归计算子矩阵的行列式 - 使用重命名后的递归方法
-            Fraction subDet = subMatrix.determinantByExpansionRecursive(history);
+            // 计算子矩阵的行列式
+            Fraction subDet = minors.minor(expandIndex, j);
             Fraction cofactorValue = Fraction(sign) * subDet;
             Fraction termValue = element * cofactorValue;
             result += termValue;
@@ -437,7 +637,7 @@ Fraction Matrix::determinantByExpansion(ExpansionHistory& history) const {
     // 按列展开
     else {
         for (size_t i = 0; i < rows; ++i) {
-            Fraction element = data[i][expandIndex];
+            Fraction element = at(i, expandIndex);
             
             // 如果元素为0，跳过（提高效率）
             if (element == Fraction(0)) {
@@ -466,8 +666,8 @@ Fraction Matrix::determinantByExpansion(ExpansionHistory& history) const {
                 expandIndex, i, element
             ));
             
-            // 递归计算子矩阵的行列式
-            Fraction subDet = subMatrix.determinantByExpansionRecursive(history);
+            // 计算子矩阵的行列式
+            Fraction subDet = minors.minor(i, expandIndex);
             Fraction cofactorValue = Fraction(sign) * subDet;
             Fraction termValue = element * cofactorValue;
             result += termValue;
@@ -505,18 +705,10 @@ Matrix Matrix::augment(const Matrix& B) const {
     
     Matrix result(rows, cols + B.cols);
     
-    // 复制当前矩阵 A 到结果的左侧
+    // 逐行拼接：A 的第 i 行在左，B 的第 i 行在右
     for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            result.at(i, j) = at(i, j);
-        }
-    }
-    
-    // 复制矩阵 B 到结果的右侧
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < B.cols; ++j) {
-            result.at(i, cols + j) = B.at(i, j);
-        }
+        Fraction* dst = std::copy(rowData(i), rowData(i) + cols, result.rowData(i));
+        std::copy(B.rowData(i), B.rowData(i) + B.cols, dst);
     }
     
     return result;
@@ -542,9 +734,7 @@ Matrix Matrix::extractRightPart(size_t colStart) const {
     Matrix result(rows, cols - colStart);
     
     for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols - colStart; ++j) {
-            result.at(i, j) = at(i, colStart + j);
-        }
+        std::copy(rowData(i) + colStart, rowData(i) + cols, result.rowData(i));
     }
     
     return result;
@@ -552,17 +742,20 @@ Matrix Matrix::extractRightPart(size_t colStart) const {
 
 // 新增：用于编辑器修改矩阵结构的方法实现
 void Matrix::addRow(size_t rowIndex, const std::vector<Fraction>& rowData) {
-    if (rowData.size() != cols && cols != 0) { // Allow adding row to 0-col matrix if rowData is also empty or cols will become rowData.size()
-        if (cols == 0 && rows == 0) { // Special case: first row in an empty matrix
-             cols = rowData.size();
-        } else {
-            throw std::invalid_argument("Row data size mismatch with matrix column count.");
-        }
+    if (rows == 0 && cols == 0) { // Special case: first row in an empty matrix
+        cols = rowData.size();
+    } else if (!rowData.empty() && rowData.size() != cols) {
+        throw std::invalid_argument("Row data size mismatch with matrix column count.");
     }
     if (rowIndex > rows) {
         throw std::out_of_range("Row index out of range for addRow.");
     }
-    data.insert(data.begin() + rowIndex, rowData.empty() && cols > 0 ? std::vector<Fraction>(cols) : rowData);
+    auto pos = data.begin() + rowIndex * cols;
+    if (rowData.empty()) {
+        data.insert(pos, cols, Fraction(0));
+    } else {
+        data.insert(pos, rowData.begin(), rowData.end());
+    }
     rows++;
 }
 
@@ -570,99 +763,85 @@ void Matrix::addRow(size_t rowIndex) {
     if (rowIndex > rows) {
         throw std::out_of_range("Row index out of range for addRow.");
     }
-    data.insert(data.begin() + rowIndex, std::vector<Fraction>(cols)); // Insert a row of zeros
+    data.insert(data.begin() + rowIndex * cols, cols, Fraction(0)); // Insert a row of zeros
     rows++;
 }
 
 void Matrix::addColumn(size_t colIndex, const std::vector<Fraction>& colData) {
-    if (colData.size() != rows && rows != 0) {
-         if (rows == 0 && cols == 0) { // Special case: first col in an empty matrix
-            rows = colData.size();
-        } else {
-            throw std::invalid_argument("Column data size mismatch with matrix row count.");
-        }
+    if (rows == 0 && cols == 0) { // Special case: first col in an empty matrix
+        rows = colData.size();
+    } else if (!colData.empty() && colData.size() != rows) {
+        throw std::invalid_argument("Column data size mismatch with matrix row count.");
     }
     if (colIndex > cols) {
         throw std::out_of_range("Column index out of range for addColumn.");
     }
-    if (rows == 0 && cols == 0 && !colData.empty()) { // Adding first column to empty matrix
-        for(const auto& val : colData) {
-            data.push_back({val});
-        }
-    } else {
-        for (size_t i = 0; i < rows; ++i) {
-            data[i].insert(data[i].begin() + colIndex, colData.empty() && rows > 0 ? Fraction(0) : colData[i]);
-        }
+    // 连续存储下插入列需要按新的行步长重新排布
+    std::vector<Fraction> newData;
+    newData.reserve(rows * (cols + 1));
+    for (size_t i = 0; i < rows; ++i) {
+        const Fraction* row = data.data() + i * cols;
+        newData.insert(newData.end(), row, row + colIndex);
+        newData.push_back(colData.empty() ? Fraction(0) : colData[i]);
+        newData.insert(newData.end(), row + colIndex, row + cols);
     }
+    data.swap(newData);
     cols++;
 }
 
 void Matrix::addColumn(size_t colIndex) {
-    if (colIndex > cols) {
-        throw std::out_of_range("Column index out of range for addColumn.");
-    }
-     if (rows == 0 && cols == 0) { // Adding a column to a completely empty matrix, results in 0-row, 1-col matrix
-        // This case is tricky. If rows is 0, adding a column of zeros means nothing changes in data.
-        // Let's assume if rows is 0, adding a column means it's still 0 rows.
-        // The editor should probably ensure matrix has at least 1 row before adding columns if it's empty.
-        // Or, default to adding a 1-row, 1-col matrix of [0] if completely empty.
-        // For now, if rows is 0, this does not change data structure for data[i].insert.
-    } else {
-        for (size_t i = 0; i < rows; ++i) {
-            data[i].insert(data[i].begin() + colIndex, Fraction(0)); // Insert zero
-        }
-    }
-    cols++;
+    addColumn(colIndex, std::vector<Fraction>());
 }
 
 void Matrix::deleteRow(size_t rowIndex) {
     if (rowIndex >= rows) {
         throw std::out_of_range("Row index out of range for deleteRow.");
     }
-    if (rows == 0) return; // Cannot delete from empty matrix
-    data.erase(data.begin() + rowIndex);
+    auto first = data.begin() + rowIndex * cols;
+    data.erase(first, first + cols);
     rows--;
-    if (rows == 0) cols = 0; // If all rows deleted, it's an empty matrix
+    if (rows == 0) { // If all rows deleted, it's an empty matrix
+        cols = 0;
+        data.clear();
+    }
 }
 
 void Matrix::deleteColumn(size_t colIndex) {
     if (colIndex >= cols) {
         throw std::out_of_range("Column index out of range for deleteColumn.");
     }
-    if (cols == 0) return; // Cannot delete from empty matrix (no columns)
+    std::vector<Fraction> newData;
+    newData.reserve(rows * (cols - 1));
     for (size_t i = 0; i < rows; ++i) {
-        if (!data[i].empty()) { // Check if row itself is not empty
-            data[i].erase(data[i].begin() + colIndex);
-        }
+        const Fraction* row = data.data() + i * cols;
+        newData.insert(newData.end(), row, row + colIndex);
+        newData.insert(newData.end(), row + colIndex + 1, row + cols);
     }
+    data.swap(newData);
     cols--;
-    if (cols == 0) rows = 0; // If all columns deleted, it's an empty matrix
+    if (cols == 0) { // If all columns deleted, it's an empty matrix
+        rows = 0;
+        data.clear();
+    }
 }
 
 void Matrix::resize(size_t newRows, size_t newCols) {
-    // Adjust rows
-    if (newRows > rows) {
-        data.insert(data.end(), newRows - rows, std::vector<Fraction>(cols, Fraction(0)));
-    } else if (newRows < rows) {
-        data.erase(data.begin() + newRows, data.end());
+    if (newRows == 0 || newCols == 0) { // If either dimension is zero, it's effectively an empty matrix
+        rows = 0;
+        cols = 0;
+        data.clear();
+        return;
     }
-    rows = newRows;
 
-    // Adjust columns for all existing rows
-    for (size_t i = 0; i < rows; ++i) {
-        if (newCols > data[i].size()) {
-            data[i].insert(data[i].end(), newCols - data[i].size(), Fraction(0));
-        } else if (newCols < data[i].size()) {
-            data[i].erase(data[i].begin() + newCols, data[i].end());
-        }
+    std::vector<Fraction> newData(newRows * newCols);
+    size_t keepRows = std::min(rows, newRows);
+    size_t keepCols = std::min(cols, newCols);
+    for (size_t i = 0; i < keepRows; ++i) {
+        std::copy(rowData(i), rowData(i) + keepCols, newData.begin() + i * newCols);
     }
+    data.swap(newData);
+    rows = newRows;
     cols = newCols;
-
-    if (rows == 0 || cols == 0) { // If either dimension is zero, it's effectively an empty matrix
-        data.clear();
-        if (rows == 0) cols = 0;
-        if (cols == 0) rows = 0;
-    }
 }
 
 // 新增：序列化方法
@@ -671,7 +850,7 @@ std::string Matrix::serialize() const {
     oss << rows << "," << cols << ":";
     for (size_t r = 0; r < rows; ++r) {
         for (size_t c = 0; c < cols; ++c) {
-            oss << data[r][c].toString(); // 使用 Fraction::toString() 以确保一致性
+            oss << at(r, c).toString(); // 使用 Fraction::toString() 以确保一致性
             if (r < rows - 1 || c < cols - 1) {
                 oss << ",";
             }
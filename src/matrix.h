@@ -3,20 +3,28 @@
 #include <iostream>
 #include <string> 
 #include "fraction.h"
+#include "matrix_view.h"
 
 // 前向声明
 class ExpansionHistory;
+class Matrix;
+
+// 新增：Matrix 的零拷贝子式视图
+using MatrixView = BasicMatrixView<Matrix>;
 
 class Matrix {
 private:
-    std::vector<std::vector<Fraction>> data;
+    // 行主序连续存储：元素 (r, c) 位于 data[r * cols + c]，行步长为 cols，列步长为 1
     size_t rows, cols;
+    std::vector<Fraction> data;
+
+    // 新增：矩阵乘法的分块参数
+    static constexpr size_t MUL_TILE = 32;                        // 输出分块与 k 方向分段的边长
+    static constexpr size_t MUL_PARALLEL_THRESHOLD = 32 * 32 * 32; // 乘加次数低于此值时串行计算
 
-    // 辅助方法：获取去掉指定行和列的子矩阵
+    // 辅助方法：获取去掉指定行和列的子矩阵（仅用于记录展开步骤的快照）
     Matrix getSubMatrix(size_t excludeRow, size_t excludeCol) const;
-    
-    // 将私有的递归方法重命名，以避免歧义
-    Fraction determinantByExpansionRecursive(ExpansionHistory& history, int depth = 0) const;
+
 
 public:
     Matrix(size_t r, size_t c);
@@ -25,8 +33,15 @@ public:
     size_t rowCount() const;
     size_t colCount() const;
 
-    Fraction& at(size_t r, size_t c);
-    const Fraction& at(size_t r, size_t c) const;
+    Fraction& at(size_t r, size_t c) { return data[r * cols + c]; }
+    const Fraction& at(size_t r, size_t c) const { return data[r * cols + c]; }
+
+    // 新增：按行访问连续存储，返回第 r 行首元素指针（该行共 colCount() 个元素）
+    Fraction* rowData(size_t r) { return data.data() + r * cols; }
+    const Fraction* rowData(size_t r) const { return data.data() + r * cols; }
+
+    // 新增：原地交换两行
+    void swapRows(size_t r1, size_t r2);
 
     void input(std::istream& is = std::cin);
     void print(std::ostream& os = std::cout) const;
@@ -1,6 +1,252 @@
 #include "matrix_operations.h"
+#include "modular_arithmetic.h"
 #include <sstream>
+#include <algorithm>
 #include <boost/lexical_cast.hpp> // 新增：用于 BigInt 到字符串的转换
+#include <boost/multiprecision/integer.hpp>
+#include "task_scheduler.h"
+#include "cancellation.h"
+#include "progress.h"
+#include <functional>
+
+EliminationMode MatrixOperations::eliminationMode = EliminationMode::BAREISS;
+
+void MatrixOperations::setEliminationMode(EliminationMode mode) {
+    eliminationMode = mode;
+}
+
+EliminationMode MatrixOperations::getEliminationMode() {
+    return eliminationMode;
+}
+
+// 无分数（Bareiss）消元引擎
+namespace {
+
+// 新增：每个主元步骤待更新的元素少于该值时串行消元，避免线程调度开销超过计算本身
+const size_t PARALLEL_ELIMINATION_MIN_WORK = 64 * 64;
+
+// 新增：对一个主元步骤内的目标行 k = first..last-1 依次调用 update。
+// 各目标行的更新互不依赖，只有在不记录步骤（步骤顺序无关紧要）且工作量足够大时才交给线程池并行，
+// 否则按 k 递增的顺序串行执行。每个元素都是精确运算，并行与串行的结果完全相同
+void forEachTargetRow(size_t first, size_t last, size_t colsToUpdate, bool recording,
+                      const std::function<void(size_t)>& update) {
+    size_t rowsToUpdate = last > first ? last - first : 0;
+    if (recording || rowsToUpdate < 2 || rowsToUpdate * colsToUpdate < PARALLEL_ELIMINATION_MIN_WORK) {
+        for (size_t k = first; k < last; ++k) {
+            update(k);
+        }
+        return;
+    }
+    TaskScheduler::parallelFor(first, last, update);
+}
+
+// 整数矩阵（行主序），供无分数消元使用
+struct IntegerMatrix {
+    size_t rows, cols;
+    std::vector<BigInt> data;
+
+    IntegerMatrix(size_t r, size_t c) : rows(r), cols(c), data(r * c) {}
+
+    BigInt& at(size_t r, size_t c) { return data[r * cols + c]; }
+    const BigInt& at(size_t r, size_t c) const { return data[r * cols + c]; }
+
+    void swapRows(size_t r1, size_t r2) {
+        std::swap_ranges(data.begin() + r1 * cols, data.begin() + (r1 + 1) * cols, data.begin() + r2 * cols);
+    }
+};
+
+// 每行乘以该行分母的最小公倍数得到整数矩阵，rowScale 记录各行的缩放因子。
+// 行缩放不改变秩和阶梯结构，行列式则需除以全部缩放因子之积。
+IntegerMatrix toIntegerRows(const Matrix& mat, std::vector<BigInt>& rowScale) {
+    IntegerMatrix result(mat.rowCount(), mat.colCount());
+    rowScale.assign(mat.rowCount(), BigInt(1));
+    for (size_t i = 0; i < mat.rowCount(); ++i) {
+        BigInt scale = 1;
+        for (size_t j = 0; j < mat.colCount(); ++j) {
+            const BigInt& den = mat.at(i, j).getDenominator();
+            if (den != 1 && scale % den != 0) {
+                scale = scale / boost::multiprecision::gcd(scale, den) * den;
+            }
+        }
+        for (size_t j = 0; j < mat.colCount(); ++j) {
+            const Fraction& value = mat.at(i, j);
+            if (value.getDenominator() == scale) {
+                result.at(i, j) = value.getNumerator();
+            } else {
+                result.at(i, j) = value.getNumerator() * (scale / value.getDenominator());
+            }
+        }
+        rowScale[i] = scale;
+    }
+    return result;
+}
+
+// Bareiss 消元：a_ij <- (p * a_ij - a_ic * a_rj) / prevPivot，其中的除法总是整除。
+// 只在前 pivotColLimit 列中选主元；fullReduce 为 true 时同时消去主元上方的元素
+// （无分数高斯-若尔当），结束后每个主元都等于最后一个主元。
+// 返回各主元所在列，每次行交换翻转 sign。
+std::vector<size_t> bareissEliminate(IntegerMatrix& m, size_t pivotColLimit, bool fullReduce, int& sign) {
+    std::vector<size_t> pivotCols;
+    BigInt prevPivot = 1;
+    size_t r = 0;
+    for (size_t c = 0; c < pivotColLimit && r < m.rows; ++c) {
+        Cancellation::checkpoint(); // 新增：每个主元步骤检查一次取消请求，下同
+        Progress::report("消元: 主元列", c + 1, pivotColLimit); // 新增：同时报告进度供界面显示
+        size_t p = r;
+        while (p < m.rows && m.at(p, c) == 0) {
+            ++p;
+        }
+        if (p == m.rows) {
+            continue; // 当前列没有主元
+        }
+        if (p != r) {
+            m.swapRows(p, r);
+            sign = -sign;
+        }
+
+        const BigInt pivot = m.at(r, c);
+        size_t firstRow = fullReduce ? 0 : r + 1;
+        size_t firstCol = fullReduce ? 0 : c + 1;
+        forEachTargetRow(firstRow, m.rows, m.cols - firstCol, false, [&](size_t i) {
+            if (i == r) {
+                return;
+            }
+            const BigInt factor = m.at(i, c);
+            BigInt tmp;
+            for (size_t j = firstCol; j < m.cols; ++j) {
+                if (j == c) {
+                    continue;
+                }
+                tmp = pivot * m.at(i, j);
+                if (factor != 0) {
+                    tmp -= factor * m.at(r, j);
+                }
+                if (prevPivot != 1) {
+                    tmp /= prevPivot;
+                }
+                m.at(i, j).swap(tmp);
+            }
+            m.at(i, c) = 0;
+        });
+
+        prevPivot = pivot;
+        pivotCols.push_back(c);
+        ++r;
+    }
+    return pivotCols;
+}
+
+// 把整数矩阵转回分数矩阵，每个非零行除以其元素的最大公约数以保持显示简洁
+Matrix toPrimitiveRows(const IntegerMatrix& m) {
+    Matrix result(m.rows, m.cols);
+    for (size_t i = 0; i < m.rows; ++i) {
+        BigInt content = 0;
+        for (size_t j = 0; j < m.cols && content != 1; ++j) {
+            if (m.at(i, j) != 0) {
+                content = boost::multiprecision::gcd(content, m.at(i, j));
+            }
+        }
+        for (size_t j = 0; j < m.cols; ++j) {
+            result.at(i, j) = Fraction(content > 1 ? BigInt(m.at(i, j) / content) : m.at(i, j));
+        }
+    }
+    return result;
+}
+
+Fraction bareissDeterminant(const Matrix& mat) {
+    size_t n = mat.rowCount();
+    if (n == 0) {
+        return Fraction(1);
+    }
+    std::vector<BigInt> rowScale;
+    IntegerMatrix m = toIntegerRows(mat, rowScale);
+    int sign = 1;
+    std::vector<size_t> pivots = bareissEliminate(m, n, false, sign);
+    if (pivots.size() < n) {
+        return Fraction(0);
+    }
+    BigInt scale = 1;
+    for (const auto& s : rowScale) {
+        scale *= s;
+    }
+    BigInt det = m.at(n - 1, n - 1);
+    return Fraction(sign > 0 ? det : BigInt(-det), scale);
+}
+
+// 多模行列式：同样先逐行通分为整数矩阵，整数行列式交给各素数上的字长消元与中国剩余定理重构
+Fraction modularDeterminant(const Matrix& mat) {
+    std::vector<BigInt> rowScale;
+    IntegerMatrix m = toIntegerRows(mat, rowScale);
+    BigInt scale = 1;
+    for (const auto& s : rowScale) {
+        scale *= s;
+    }
+    return Fraction(ModularOperations::integerDeterminant(m.data, m.rows), scale);
+}
+
+// 阶数达到该值时，Bareiss 模式下的行列式改用多模算法
+const size_t MODULAR_DETERMINANT_MIN_SIZE = 16;
+
+// 新增：Berkowitz 算法求整数方阵 B 的特征多项式 det(xI - B)，系数按 x 的降幂排列（首项为 1）。
+// 设 B_r 为左上角 r 阶子阵，B_r = [B_{r-1} S; R b_rr]，则
+//     p_r = T_r p_{r-1}，T_r 为首列 (1, -b_rr, -R S, -R B_{r-1} S, ..., -R B_{r-1}^{r-2} S) 的下三角 Toeplitz 矩阵。
+// 全程只有整数加法和乘法，没有除法，共 O(n^4) 次运算
+std::vector<BigInt> berkowitz(const IntegerMatrix& b) {
+    size_t n = b.rows;
+    std::vector<BigInt> poly{BigInt(1)};
+    std::vector<BigInt> toeplitz, column, next;
+    for (size_t r = 1; r <= n; ++r) {
+        Cancellation::checkpoint();
+        Progress::report("特征多项式: 子阵阶数", r, n);
+        size_t m = r - 1; // B_{r-1} 的阶数，新加入的行列下标为 m
+        toeplitz.assign(r + 1, BigInt(0));
+        toeplitz[0] = 1;
+        toeplitz[1] = -b.at(m, m);
+
+        // column 依次为 S, B_{r-1} S, B_{r-1}^2 S, ...
+        column.resize(m);
+        for (size_t i = 0; i < m; ++i) {
+            column[i] = b.at(i, m);
+        }
+        for (size_t k = 0; k < m; ++k) {
+            BigInt dot = 0;
+            for (size_t j = 0; j < m; ++j) {
+                if (column[j] != 0 && b.at(m, j) != 0) {
+                    dot += b.at(m, j) * column[j];
+                }
+            }
+            toeplitz[k + 2] = -dot;
+            if (k + 1 == m) {
+                break;
+            }
+            next.assign(m, BigInt(0));
+            forEachTargetRow(0, m, m, false, [&](size_t i) {
+                BigInt acc = 0;
+                for (size_t j = 0; j < m; ++j) {
+                    if (column[j] != 0 && b.at(i, j) != 0) {
+                        acc += b.at(i, j) * column[j];
+                    }
+                }
+                next[i].swap(acc);
+            });
+            column.swap(next);
+        }
+
+        // p_r = T_r p_{r-1}，T_r 为 (r+1) x r 的下三角 Toeplitz 矩阵
+        next.assign(r + 1, BigInt(0));
+        for (size_t i = 0; i <= r; ++i) {
+            for (size_t j = 0; j < r && j <= i; ++j) {
+                if (toeplitz[i - j] != 0 && poly[j] != 0) {
+                    next[i] += toeplitz[i - j] * poly[j];
+                }
+            }
+        }
+        poly.swap(next);
+    }
+    return poly;
+}
+
+} // namespace
 
 // 实现初等行变换 - 返回新矩阵
 Matrix MatrixOperations::swapRows(const Matrix& mat, size_t row1, size_t row2) {
@@ -9,11 +255,7 @@ Matrix MatrixOperations::swapRows(const Matrix& mat, size_t row1, size_t row2) {
     }
     
     Matrix result = mat;
-    for (size_t j = 0; j < mat.colCount(); ++j) {
-        Fraction temp = result.at(row1, j);
-        result.at(row1, j) = result.at(row2, j);
-        result.at(row2, j) = temp;
-    }
+    result.swapRows(row1, row2);
     return result;
 }
 
@@ -39,7 +281,7 @@ Matrix MatrixOperations::addScaledRow(const Matrix& mat, size_t targetRow, size_
     
     Matrix result = mat;
     for (size_t j = 0; j < mat.colCount(); ++j) {
-        result.at(targetRow, j) = result.at(targetRow, j) + result.at(sourceRow, j) * scalar;
+        result.at(targetRow, j) = RationalAccumulator(result.at(targetRow, j)).fma(result.at(sourceRow, j), scalar).result();
     }
     return result;
 }
@@ -50,21 +292,18 @@ void MatrixOperations::swapRows(Matrix& mat, size_t row1, size_t row2, Operation
         throw std::out_of_range("Row index out of range in swapRows");
     }
     
-    for (size_t j = 0; j < mat.colCount(); ++j) {
-        Fraction temp = mat.at(row1, j);
-        mat.at(row1, j) = mat.at(row2, j);
-        mat.at(row2, j) = temp;
-    }
-    
-    std::stringstream ss;
-    ss << "交换第 " << (row1 + 1) << " 行和第 " << (row2 + 1) << " 行";
+    mat.swapRows(row1, row2);
     
-    history.addStep(OperationStep(
-        OperationType::SWAP_ROWS,
-        ss.str(),
-        mat,
-        row1, row2
-    ));
+    if (history.isRecording()) {
+        std::stringstream ss;
+        ss << "交换第 " << (row1 + 1) << " 行和第 " << (row2 + 1) << " 行";
+        history.addStep(
+            OperationType::SWAP_ROWS,
+            ss.str(),
+            mat,
+            row1, row2
+        );
+    }
 }
 
 void MatrixOperations::scaleRow(Matrix& mat, size_t row, const Fraction& scalar, OperationHistory& history) {
@@ -79,15 +318,16 @@ void MatrixOperations::scaleRow(Matrix& mat, size_t row, const Fraction& scalar,
         mat.at(row, j) = mat.at(row, j) * scalar;
     }
     
-    std::stringstream ss;
-    ss << "将第 " << (row + 1) << " 行乘以 " << scalar;
-    
-    history.addStep(OperationStep(
-        OperationType::SCALE_ROW,
-        ss.str(),
-        mat,
-        row, -1, scalar
-    ));
+    if (history.isRecording()) {
+        std::stringstream ss;
+        ss << "将第 " << (row + 1) << " 行乘以 " << scalar;
+        history.addStep(
+            OperationType::SCALE_ROW,
+            ss.str(),
+            mat,
+            row, -1, scalar
+        );
+    }
 }
 
 void MatrixOperations::addScaledRow(Matrix& mat, size_t targetRow, size_t sourceRow, const Fraction& scalar, OperationHistory& history) {
@@ -96,41 +336,48 @@ void MatrixOperations::addScaledRow(Matrix& mat, size_t targetRow, size_t source
     }
     
     for (size_t j = 0; j < mat.colCount(); ++j) {
-        mat.at(targetRow, j) = mat.at(targetRow, j) + mat.at(sourceRow, j) * scalar;
+        mat.at(targetRow, j) = RationalAccumulator(mat.at(targetRow, j)).fma(mat.at(sourceRow, j), scalar).result();
     }
     
-    std::stringstream ss;
-    ss << "将第 " << (sourceRow + 1) << " 行乘以 " << scalar << " 加到第 " << (targetRow + 1) << " 行";
-    
-    history.addStep(OperationStep(
-        OperationType::ADD_SCALED_ROW,
-        ss.str(),
-        mat,
-        targetRow, sourceRow, scalar
-    ));
+    if (history.isRecording()) {
+        std::stringstream ss;
+        ss << "将第 " << (sourceRow + 1) << " 行乘以 " << scalar << " 加到第 " << (targetRow + 1) << " 行";
+        history.addStep(
+            OperationType::ADD_SCALED_ROW,
+            ss.str(),
+            mat,
+            targetRow, sourceRow, scalar
+        );
+    }
 }
 
 // 化简为行阶梯形（高斯消元法）
+// 行阶梯形不唯一，各行的倍数取决于消元方式；这里始终走有理数消元，
+// 保证是否显示步骤、选用哪个消元引擎都得到同一个结果
 Matrix MatrixOperations::toRowEchelonForm(const Matrix& mat) {
     Matrix result = mat;
-    OperationHistory dummy; // 不记录历史
+    NullOperationHistory dummy; // 不记录历史
     toRowEchelonForm(result, dummy);
     return result;
 }
 
 void MatrixOperations::toRowEchelonForm(Matrix& mat, OperationHistory& history) {
     // 记录初始状态
-    history.addStep(OperationStep(
-        OperationType::INITIAL_STATE,
-        "初始矩阵:",
-        mat
-    ));
+    if (history.isRecording()) {
+        history.addStep(
+            OperationType::INITIAL_STATE,
+            "初始矩阵:",
+            mat
+        );
+    }
     
     size_t lead = 0;
     size_t rowCount = mat.rowCount();
     size_t colCount = mat.colCount();
     
     for (size_t r = 0; r < rowCount; ++r) {
+        Cancellation::checkpoint();
+        Progress::report("消元: 主元行", r + 1, rowCount);
         if (lead >= colCount) {
             break;
         }
@@ -170,41 +417,120 @@ void MatrixOperations::toRowEchelonForm(Matrix& mat, OperationHistory& history)
         //     scaleRow(mat, r, Fraction(1) / pivot, history);
         // }
         
-        // 消去下方行的对应元素
-        for (size_t k = r + 1; k < rowCount; ++k) { // 使用 k 避免与外层 i 混淆
+        const Fraction pivotForElimination = mat.at(r, lead); // 此处主元应为整数或已处理过的形式
+        if (pivotForElimination == Fraction(0)) {
+            // 这种情况理论上不应发生，因为我们已经找到了非零主元并可能对其进行了缩放
+            // 但为防止除以零，添加检查
+            throw std::logic_error("Pivot for elimination is zero, which should not happen here.");
+        }
+
+        // 消去下方行的对应元素（不记录步骤时各行并行处理）
+        forEachTargetRow(r + 1, rowCount, colCount, history.isRecording(), [&](size_t k) { // 使用 k 避免与外层 i 混淆
             Fraction factor = mat.at(k, lead); // 要消去的元素
             if (factor != Fraction(0)) {
-                Fraction pivotForElimination = mat.at(r, lead); // 此处主元应为整数或已处理过的形式
-                if (pivotForElimination == Fraction(0)) {
-                    // 这种情况理论上不应发生，因为我们已经找到了非零主元并可能对其进行了缩放
-                    // 但为防止除以零，添加检查
-                    throw std::logic_error("Pivot for elimination is zero, which should not happen here.");
-                }
                 // 直接计算消元系数
                 Fraction elimFactor = -factor / pivotForElimination;
                 addScaledRow(mat, k, r, elimFactor, history);
             }
-        }
+        });
         
         ++lead;
     }
     
     // 记录最终状态
-    history.addStep(OperationStep(
-        OperationType::RESULT_STATE,
-        "行阶梯形矩阵:",
-        mat
-    ));
+    if (history.isRecording()) {
+        history.addStep(
+            OperationType::RESULT_STATE,
+            "行阶梯形矩阵:",
+            mat
+        );
+    }
 }
 
 // 化简为最简行阶梯形（高斯-若尔当消元法）
 Matrix MatrixOperations::toReducedRowEchelonForm(const Matrix& mat) {
+    if (eliminationMode == EliminationMode::BAREISS) {
+        std::vector<BigInt> rowScale;
+        IntegerMatrix m = toIntegerRows(mat, rowScale);
+        int sign = 1;
+        std::vector<size_t> pivots = bareissEliminate(m, m.cols, true, sign);
+        // 无分数高斯-若尔当的结果是 d * RREF，逐行除以主元即得最简行阶梯形
+        Matrix result(m.rows, m.cols);
+        for (size_t i = 0; i < pivots.size(); ++i) {
+            const BigInt& pivot = m.at(i, pivots[i]);
+            for (size_t j = 0; j < m.cols; ++j) {
+                if (m.at(i, j) != 0) {
+                    result.at(i, j) = Fraction(m.at(i, j), pivot);
+                }
+            }
+        }
+        return result;
+    }
     Matrix result = mat;
-    OperationHistory dummy; // 不记录历史
+    NullOperationHistory dummy; // 不记录历史
     toReducedRowEchelonForm(result, dummy);
     return result;
 }
 
+Matrix MatrixOperations::toReducedRowEchelonForm(const Matrix& mat, size_t pivotColLimit, std::vector<size_t>& pivotCols) {
+    pivotColLimit = std::min(pivotColLimit, mat.colCount());
+    if (eliminationMode == EliminationMode::BAREISS) {
+        std::vector<BigInt> rowScale;
+        IntegerMatrix m = toIntegerRows(mat, rowScale);
+        int sign = 1;
+        pivotCols = bareissEliminate(m, pivotColLimit, true, sign);
+        Matrix result = toPrimitiveRows(m);
+        for (size_t i = 0; i < pivotCols.size(); ++i) {
+            const BigInt& pivot = m.at(i, pivotCols[i]);
+            for (size_t j = 0; j < m.cols; ++j) {
+                result.at(i, j) = m.at(i, j) != 0 ? Fraction(m.at(i, j), pivot) : Fraction(0);
+            }
+        }
+        return result;
+    }
+
+    Matrix result = mat;
+    pivotCols.clear();
+    size_t cols = result.colCount();
+    size_t r = 0;
+    for (size_t c = 0; c < pivotColLimit && r < result.rowCount(); ++c) {
+        Cancellation::checkpoint();
+        Progress::report("消元: 主元列", c + 1, pivotColLimit);
+        size_t p = r;
+        while (p < result.rowCount() && result.at(p, c) == Fraction(0)) {
+            ++p;
+        }
+        if (p == result.rowCount()) {
+            continue;
+        }
+        if (p != r) {
+            result.swapRows(p, r);
+        }
+        Fraction* pivotRow = result.rowData(r);
+        const Fraction pivot = pivotRow[c];
+        for (size_t j = 0; j < cols; ++j) {
+            if (pivotRow[j] != Fraction(0)) {
+                pivotRow[j] = pivotRow[j] / pivot;
+            }
+        }
+        forEachTargetRow(0, result.rowCount(), cols, false, [&](size_t i) {
+            Fraction* row = result.rowData(i);
+            if (i == r || row[c] == Fraction(0)) {
+                return;
+            }
+            const Fraction factor = row[c];
+            for (size_t j = 0; j < cols; ++j) {
+                if (pivotRow[j] != Fraction(0)) {
+                    row[j] = RationalAccumulator(row[j]).fms(pivotRow[j], factor).result();
+                }
+            }
+        });
+        pivotCols.push_back(c);
+        ++r;
+    }
+    return result;
+}
+
 void MatrixOperations::toReducedRowEchelonForm(Matrix& mat, OperationHistory& history) {
     // 先转化为行阶梯形
     toRowEchelonForm(mat, history);
@@ -237,6 +563,8 @@ void MatrixOperations::toReducedRowEchelonForm(Matrix& mat, OperationHistory& hi
     
     // 从下往上消元，使每个主元上方的元素都为0
     for (int r = rowCount - 1; r >= 0; --r) {
+        Cancellation::checkpoint();
+        Progress::report("回代消元: 行", rowCount - r, rowCount);
         // 找到当前行的主元位置
         int lead = -1;
         for (size_t j = 0; j < colCount; ++j) {
@@ -250,25 +578,35 @@ void MatrixOperations::toReducedRowEchelonForm(Matrix& mat, OperationHistory& hi
             continue; // 当前行没有主元
         }
         
-        // 消去该主元列上方的所有元素
-        for (int i = r - 1; i >= 0; --i) {
+        // 消去该主元列上方的所有元素（不记录步骤时各行并行处理）
+        // 第 k 个目标行是第 r-1-k 行，串行时保持从下往上的顺序
+        forEachTargetRow(0, r, colCount, history.isRecording(), [&](size_t k) {
+            size_t i = r - 1 - k;
             Fraction factor = mat.at(i, lead);
             if (factor != Fraction(0)) {
                 addScaledRow(mat, i, r, -factor, history);
             }
-        }
+        });
     }
     
     // 记录最终状态
-    history.addStep(OperationStep(
-        OperationType::RESULT_STATE,
-        "最简行阶梯形矩阵:",
-        mat
-    ));
+    if (history.isRecording()) {
+        history.addStep(
+            OperationType::RESULT_STATE,
+            "最简行阶梯形矩阵:",
+            mat
+        );
+    }
 }
 
 // 计算矩阵的秩
 int MatrixOperations::rank(const Matrix& mat) {
+    if (eliminationMode == EliminationMode::BAREISS) {
+        std::vector<BigInt> rowScale;
+        IntegerMatrix m = toIntegerRows(mat, rowScale);
+        int sign = 1;
+        return static_cast<int>(bareissEliminate(m, m.cols, false, sign).size());
+    }
     Matrix rref = toReducedRowEchelonForm(mat);
     int rank = 0;
     
@@ -291,10 +629,62 @@ int MatrixOperations::rank(const Matrix& mat) {
 
 // 计算方阵的行列式
 Fraction MatrixOperations::determinant(const Matrix& mat) {
-    OperationHistory dummy; // 不记录历史
+    if (eliminationMode == EliminationMode::BAREISS) {
+        if (mat.rowCount() != mat.colCount()) {
+            throw std::invalid_argument("Determinant can only be calculated for square matrices");
+        }
+        if (mat.rowCount() >= MODULAR_DETERMINANT_MIN_SIZE) {
+            return modularDeterminant(mat);
+        }
+        return bareissDeterminant(mat);
+    }
+    NullOperationHistory dummy; // 不记录历史
     return determinant(mat, dummy);
 }
 
+Fraction MatrixOperations::determinantModular(const Matrix& mat) {
+    if (mat.rowCount() != mat.colCount()) {
+        throw std::invalid_argument("Determinant can only be calculated for square matrices");
+    }
+    return modularDeterminant(mat);
+}
+
+std::vector<Fraction> MatrixOperations::characteristicPolynomial(const Matrix& mat) {
+    if (mat.rowCount() != mat.colCount()) {
+        throw std::invalid_argument("Characteristic polynomial can only be calculated for square matrices");
+    }
+    size_t n = mat.rowCount();
+
+    // 整体乘以全部分母的最小公倍数 d 得到整数矩阵 B = d A。
+    // 由 det(xI - A) = d^{-n} det(dx I - B)，B 的降幂第 i 个系数除以 d^i 即为 A 的对应系数
+    BigInt d = 1;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const BigInt& den = mat.at(i, j).getDenominator();
+            if (den != 1 && d % den != 0) {
+                d = d / boost::multiprecision::gcd(d, den) * den;
+            }
+        }
+    }
+    IntegerMatrix b(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const Fraction& value = mat.at(i, j);
+            b.at(i, j) = value.getDenominator() == d ? value.getNumerator()
+                                                     : BigInt(value.getNumerator() * (d / value.getDenominator()));
+        }
+    }
+
+    std::vector<BigInt> descending = berkowitz(b);
+    std::vector<Fraction> coefficients(n + 1);
+    BigInt scale = 1;
+    for (size_t i = 0; i <= n; ++i) {
+        coefficients[n - i] = Fraction(descending[i], scale);
+        scale *= d;
+    }
+    return coefficients;
+}
+
 Fraction MatrixOperations::determinant(const Matrix& mat, OperationHistory& history) {
     if (mat.rowCount() != mat.colCount()) {
         throw std::invalid_argument("Determinant can only be calculated for square matrices");
@@ -305,44 +695,52 @@ Fraction MatrixOperations::determinant(const Matrix& mat, OperationHistory& hist
     // 特殊情况处理
     if (n == 1) {
         Fraction result = mat.at(0, 0);
-        history.addStep(OperationStep(
-            OperationType::RESULT_STATE,
-            "行列式为: " + boost::lexical_cast<std::string>(result.getNumerator()) + 
-            (result.getDenominator() != 1 ? "/" + boost::lexical_cast<std::string>(result.getDenominator()) : ""),
-            mat
-        ));
+        if (history.isRecording()) {
+            history.addStep(
+                OperationType::RESULT_STATE,
+                "行列式为: " + boost::lexical_cast<std::string>(result.getNumerator()) + 
+                (result.getDenominator() != 1 ? "/" + boost::lexical_cast<std::string>(result.getDenominator()) : ""),
+                mat
+            );
+        }
         return result;
     }
     
     if (n == 2) {
         Fraction result = mat.at(0, 0) * mat.at(1, 1) - mat.at(0, 1) * mat.at(1, 0);
-        std::stringstream ss;
-        ss << "2x2行列式计算: " << mat.at(0, 0) << " * " << mat.at(1, 1) << " - " 
-           << mat.at(0, 1) << " * " << mat.at(1, 0) << " = " << result;
-        history.addStep(OperationStep(
-            OperationType::RESULT_STATE,
-            ss.str(),
-            mat
-        ));
+        if (history.isRecording()) {
+            std::stringstream ss;
+            ss << "2x2行列式计算: " << mat.at(0, 0) << " * " << mat.at(1, 1) << " - " 
+               << mat.at(0, 1) << " * " << mat.at(1, 0) << " = " << result;
+            history.addStep(
+                OperationType::RESULT_STATE,
+                ss.str(),
+                mat
+            );
+        }
         return result;
     }
     
     // 对于较大的矩阵，使用高斯消元法计算行列式
     Matrix copy = mat;
     
-    std::stringstream initial;
-    initial << "计算行列式的初始矩阵 (当前因子: 1)";
-    history.addStep(OperationStep(
-        OperationType::INITIAL_STATE,
-        initial.str(),
-        copy
-    ));
+    if (history.isRecording()) {
+        std::stringstream initial;
+        initial << "计算行列式的初始矩阵 (当前因子: 1)";
+        history.addStep(
+            OperationType::INITIAL_STATE,
+            initial.str(),
+            copy
+        );
+    }
     
     Fraction det(1); // 行列式的值
     int sign = 1;    // 交换行时的符号
     
     size_t lead = 0;
     for (size_t r = 0; r < n; ++r) {
+        Cancellation::checkpoint();
+        Progress::report("行列式消元: 主元", r + 1, n);
         if (lead >= n) {
             break;
         }
@@ -360,81 +758,87 @@ Fraction MatrixOperations::determinant(const Matrix& mat, OperationHistory& hist
         
         if (copy.at(maxRow, lead) == Fraction(0)) {
             // 如果主元为0，则行列式为0
-            std::stringstream ss;
-            ss << "主元为0，行列式为0 (当前累积因子: " << (sign > 0 ? "" : "-") << det << ")";
-            history.addStep(OperationStep(
-                OperationType::RESULT_STATE,
-                ss.str(),
-                copy
-            ));
+            if (history.isRecording()) {
+                std::stringstream ss;
+                ss << "主元为0，行列式为0 (当前累积因子: " << (sign > 0 ? "" : "-") << det << ")";
+                history.addStep(
+                    OperationType::RESULT_STATE,
+                    ss.str(),
+                    copy
+                );
+            }
             return Fraction(0);
         }
         
         // 交换行
         if (maxRow != r) {
-            for (size_t j = 0; j < n; ++j) {
-                Fraction temp = copy.at(r, j);
-                copy.at(r, j) = copy.at(maxRow, j);
-                copy.at(maxRow, j) = temp;
-            }
+            copy.swapRows(r, maxRow);
             
             sign = -sign; // 交换行改变行列式符号
             
-            std::stringstream ss;
-            ss << "交换第 " << (r + 1) << " 行和第 " << (maxRow + 1) 
-               << " 行 (符号变为: " << (sign > 0 ? "+" : "-") 
-               << ", 当前累积因子: " << (sign > 0 ? "" : "-") << det << ")";
-            history.addStep(OperationStep(
-                OperationType::SWAP_ROWS,
-                ss.str(),
-                copy,
-                r, maxRow
-            ));
+            if (history.isRecording()) {
+                std::stringstream ss;
+                ss << "交换第 " << (r + 1) << " 行和第 " << (maxRow + 1) 
+                   << " 行 (符号变为: " << (sign > 0 ? "+" : "-") 
+                   << ", 当前累积因子: " << (sign > 0 ? "" : "-") << det << ")";
+                history.addStep(
+                    OperationType::SWAP_ROWS,
+                    ss.str(),
+                    copy,
+                    r, maxRow
+                );
+            }
         }
         
         // 当前主元
         Fraction pivot = copy.at(r, lead);
         det = det * pivot; // 累乘主元得到行列式
         
-        std::stringstream ss_pivot;
-        ss_pivot << "主元 " << pivot << " 加入计算 (当前累积因子: " 
-                 << (sign > 0 ? "" : "-") << det << ")";
-        history.addStep(OperationStep(
-            OperationType::RESULT_STATE,
-            ss_pivot.str(),
-            copy
-        ));
+        if (history.isRecording()) {
+            std::stringstream ss_pivot;
+            ss_pivot << "主元 " << pivot << " 加入计算 (当前累积因子: " 
+                     << (sign > 0 ? "" : "-") << det << ")";
+            history.addStep(
+                OperationType::RESULT_STATE,
+                ss_pivot.str(),
+                copy
+            );
+        }
         
         // 归一化当前行（仅用于显示，不影响行列式计算）
         for (size_t j = lead; j < n; ++j) {
             copy.at(r, j) = copy.at(r, j) / pivot;
         }
         
-        std::stringstream ss;
-        ss << "将第 " << (r + 1) << " 行除以主元 " << pivot;
-        history.addStep(OperationStep(
-            OperationType::SCALE_ROW,
-            ss.str(),
-            copy,
-            r, -1, Fraction(1) / pivot
-        ));
+        if (history.isRecording()) {
+            std::stringstream ss;
+            ss << "将第 " << (r + 1) << " 行除以主元 " << pivot;
+            history.addStep(
+                OperationType::SCALE_ROW,
+                ss.str(),
+                copy,
+                r, -1, Fraction(1) / pivot
+            );
+        }
         
         // 消元
         for (size_t i = r + 1; i < n; ++i) {
             Fraction factor = copy.at(i, lead);
             for (size_t j = lead; j < n; ++j) {
-                copy.at(i, j) = copy.at(i, j) - copy.at(r, j) * factor;
+                copy.at(i, j) = RationalAccumulator(copy.at(i, j)).fms(copy.at(r, j), factor).result();
             }
             
             if (factor != Fraction(0)) {
-                std::stringstream ss2;
-                ss2 << "将第 " << (r + 1) << " 行乘以 " << -factor << " 加到第 " << (i + 1) << " 行";
-                history.addStep(OperationStep(
-                    OperationType::ADD_SCALED_ROW,
-                    ss2.str(),
-                    copy,
-                    i, r, -factor
-                ));
+                if (history.isRecording()) {
+                    std::stringstream ss2;
+                    ss2 << "将第 " << (r + 1) << " 行乘以 " << -factor << " 加到第 " << (i + 1) << " 行";
+                    history.addStep(
+                        OperationType::ADD_SCALED_ROW,
+                        ss2.str(),
+                        copy,
+                        i, r, -factor
+                    );
+                }
             }
         }
         
@@ -442,14 +846,16 @@ Fraction MatrixOperations::determinant(const Matrix& mat, OperationHistory& hist
     }
     
     Fraction finalDet = Fraction(sign) * det;
-    std::stringstream final;
-    final << "行列式计算完成，值为: " << finalDet 
-          << " (" << (sign > 0 ? "" : "-") << det << ")";
-    history.addStep(OperationStep(
-        OperationType::RESULT_STATE,
-        final.str(),
-        copy
-    ));
+    if (history.isRecording()) {
+        std::stringstream final;
+        final << "行列式计算完成，值为: " << finalDet 
+              << " (" << (sign > 0 ? "" : "-") << det << ")";
+        history.addStep(
+            OperationType::RESULT_STATE,
+            final.str(),
+            copy
+        );
+    }
     
     return finalDet;
 }
@@ -476,7 +882,7 @@ Fraction MatrixOperations::determinantByExpansion(const Matrix& mat, ExpansionHi
 
 // 计算逆矩阵 (伴随矩阵法) - 不带历史记录
 Matrix MatrixOperations::inverse(const Matrix& mat) {
-    OperationHistory dummy;
+    NullOperationHistory dummy;
     return inverse(mat, dummy);
 }
 
@@ -487,45 +893,51 @@ Matrix MatrixOperations::inverse(const Matrix& mat, OperationHistory& history) {
     }
     
     // 记录初始状态
-    history.addStep(OperationStep(
-        OperationType::INITIAL_STATE,
-        "计算逆矩阵 (伴随矩阵法) - 初始矩阵:",
-        mat
-    ));
+    if (history.isRecording()) {
+        history.addStep(
+            OperationType::INITIAL_STATE,
+            "计算逆矩阵 (伴随矩阵法) - 初始矩阵:",
+            mat
+        );
+    }
     
     // 计算行列式
     Fraction det = determinant(mat);
     
     // 检查矩阵是否可逆
     if (det == Fraction(0)) {
-        std::stringstream ss;
-        ss << "矩阵不可逆，行列式为0";
-        history.addStep(OperationStep(
-            OperationType::RESULT_STATE,
-            ss.str(),
-            mat
-        ));
+        if (history.isRecording()) {
+            std::stringstream ss;
+            ss << "矩阵不可逆，行列式为0";
+            history.addStep(
+                OperationType::RESULT_STATE,
+                ss.str(),
+                mat
+            );
+        }
         throw std::runtime_error("Matrix is not invertible (determinant is zero)");
     }
     
     // 计算伴随矩阵
     Matrix adj = adjugate(mat);
     
-    std::stringstream ss1;
-    ss1 << "计算行列式值: " << det;
-    history.addStep(OperationStep(
-        OperationType::RESULT_STATE,
-        ss1.str(),
-        mat
-    ));
-    
-    std::stringstream ss2;
-    ss2 << "计算伴随矩阵:";
-    history.addStep(OperationStep(
-        OperationType::RESULT_STATE,
-        ss2.str(),
-        adj
-    ));
+    if (history.isRecording()) {
+        std::stringstream ss1;
+        ss1 << "计算行列式值: " << det;
+        history.addStep(
+            OperationType::RESULT_STATE,
+            ss1.str(),
+            mat
+        );
+        
+        std::stringstream ss2;
+        ss2 << "计算伴随矩阵:";
+        history.addStep(
+            OperationType::RESULT_STATE,
+            ss2.str(),
+            adj
+        );
+    }
     
     // 计算逆矩阵 A^(-1) = adj(A) / det(A)
     Matrix result = adj;
@@ -535,20 +947,45 @@ Matrix MatrixOperations::inverse(const Matrix& mat, OperationHistory& history) {
         }
     }
     
-    std::stringstream ss3;
-    ss3 << "计算逆矩阵 A^(-1) = adj(A) / det(A) = adj(A) / " << det;
-    history.addStep(OperationStep(
-        OperationType::RESULT_STATE,
-        ss3.str(),
-        result
-    ));
+    if (history.isRecording()) {
+        std::stringstream ss3;
+        ss3 << "计算逆矩阵 A^(-1) = adj(A) / det(A) = adj(A) / " << det;
+        history.addStep(
+            OperationType::RESULT_STATE,
+            ss3.str(),
+            result
+        );
+    }
     
     return result;
 }
 
 // 计算逆矩阵 (高斯-若尔当消元法) - 不带历史记录
 Matrix MatrixOperations::inverseGaussJordan(const Matrix& mat) {
-    OperationHistory dummy;
+    if (eliminationMode == EliminationMode::BAREISS) {
+        if (mat.rowCount() != mat.colCount()) {
+            throw std::invalid_argument("Inverse can only be calculated for square matrices");
+        }
+        size_t n = mat.rowCount();
+        // 对 [A|I] 逐行通分后做无分数高斯-若尔当：左侧变为 d*I，右侧即 d*A^(-1)
+        std::vector<BigInt> rowScale;
+        IntegerMatrix m = toIntegerRows(mat.augment(Matrix::identity(n)), rowScale);
+        int sign = 1;
+        std::vector<size_t> pivots = bareissEliminate(m, n, true, sign);
+        if (pivots.size() < n) {
+            throw std::runtime_error("Matrix is not invertible");
+        }
+        Matrix result(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                if (m.at(i, n + j) != 0) {
+                    result.at(i, j) = Fraction(m.at(i, n + j), m.at(i, i));
+                }
+            }
+        }
+        return result;
+    }
+    NullOperationHistory dummy;
     return inverseGaussJordan(mat, dummy);
 }
 
@@ -567,19 +1004,23 @@ Matrix MatrixOperations::inverseGaussJordan(const Matrix& mat, OperationHistory&
     Matrix augmented = mat.augment(identity);
     
     // 记录初始状态
-    std::stringstream ss_init;
-    ss_init << "计算逆矩阵 (高斯-若尔当消元法) - 创建增广矩阵 [A|I]:";
-    history.addStep(OperationStep(
-        OperationType::INITIAL_STATE,
-        ss_init.str(),
-        augmented
-    ));
+    if (history.isRecording()) {
+        std::stringstream ss_init;
+        ss_init << "计算逆矩阵 (高斯-若尔当消元法) - 创建增广矩阵 [A|I]:";
+        history.addStep(
+            OperationType::INITIAL_STATE,
+            ss_init.str(),
+            augmented
+        );
+    }
     
     // 应用高斯-若尔当消元法
     size_t lead = 0;
     
     // 前向消元：将左侧矩阵化为上三角形
     for (size_t r = 0; r < n; ++r) {
+        Cancellation::checkpoint();
+        Progress::report("求逆消元: 主元", r + 1, n);
         if (lead >= n) {
             break;
         }
@@ -593,45 +1034,47 @@ Matrix MatrixOperations::inverseGaussJordan(const Matrix& mat, OperationHistory&
         
         if (i == n) {
             // 当前列全为0，表示矩阵不可逆
-            std::stringstream ss;
-            ss << "矩阵不可逆，无法完成消元";
-            history.addStep(OperationStep(
-                OperationType::RESULT_STATE,
-                ss.str(),
-                augmented
-            ));
+            if (history.isRecording()) {
+                std::stringstream ss;
+                ss << "矩阵不可逆，无法完成消元";
+                history.addStep(
+                    OperationType::RESULT_STATE,
+                    ss.str(),
+                    augmented
+                );
+            }
             throw std::runtime_error("Matrix is not invertible");
         }
         
         // 如果主元不在当前行，交换行
         if (i != r) {
-            for (size_t j = 0; j < augmented.colCount(); ++j) {
-                Fraction temp = augmented.at(r, j);
-                augmented.at(r, j) = augmented.at(i, j);
-                augmented.at(i, j) = temp;
-            }
+            augmented.swapRows(r, i);
             
-            std::stringstream ss;
-            ss << "交换第 " << (r + 1) << " 行和第 " << (i + 1) << " 行";
-            history.addStep(OperationStep(
-                OperationType::SWAP_ROWS,
-                ss.str(),
-                augmented,
-                r, i
-            ));
+            if (history.isRecording()) {
+                std::stringstream ss;
+                ss << "交换第 " << (r + 1) << " 行和第 " << (i + 1) << " 行";
+                history.addStep(
+                    OperationType::SWAP_ROWS,
+                    ss.str(),
+                    augmented,
+                    r, i
+                );
+            }
         }
         
         // 将主元归一化
         Fraction pivot = augmented.at(r, lead);
         if (pivot == Fraction(0)) {
             // 如果主元为0，则矩阵不可逆
-            std::stringstream ss;
-            ss << "主元为0，矩阵不可逆";
-            history.addStep(OperationStep(
-                OperationType::RESULT_STATE,
-                ss.str(),
-                augmented
-            ));
+            if (history.isRecording()) {
+                std::stringstream ss;
+                ss << "主元为0，矩阵不可逆";
+                history.addStep(
+                    OperationType::RESULT_STATE,
+                    ss.str(),
+                    augmented
+                );
+            }
             throw std::runtime_error("Matrix is not invertible (zero pivot encountered)");
         }
         
@@ -639,14 +1082,16 @@ Matrix MatrixOperations::inverseGaussJordan(const Matrix& mat, OperationHistory&
             augmented.at(r, j) = augmented.at(r, j) / pivot;
         }
         
-        std::stringstream ss;
-        ss << "将第 " << (r + 1) << " 行除以主元 " << pivot;
-        history.addStep(OperationStep(
-            OperationType::SCALE_ROW,
-            ss.str(),
-            augmented,
-            r, -1, Fraction(1) / pivot
-        ));
+        if (history.isRecording()) {
+            std::stringstream ss;
+            ss << "将第 " << (r + 1) << " 行除以主元 " << pivot;
+            history.addStep(
+                OperationType::SCALE_ROW,
+                ss.str(),
+                augmented,
+                r, -1, Fraction(1) / pivot
+            );
+        }
         
         // 消去其他行的相应元素
         for (size_t i = 0; i < n; ++i) {
@@ -654,17 +1099,19 @@ Matrix MatrixOperations::inverseGaussJordan(const Matrix& mat, OperationHistory&
                 Fraction factor = augmented.at(i, lead);
                 if (factor != Fraction(0)) {
                     for (size_t j = 0; j < augmented.colCount(); ++j) {
-                        augmented.at(i, j) = augmented.at(i, j) - augmented.at(r, j) * factor;
+                        augmented.at(i, j) = RationalAccumulator(augmented.at(i, j)).fms(augmented.at(r, j), factor).result();
                     }
                     
-                    std::stringstream ss2;
-                    ss2 << "将第 " << (r + 1) << " 行乘以 " << -factor << " 加到第 " << (i + 1) << " 行";
-                    history.addStep(OperationStep(
-                        OperationType::ADD_SCALED_ROW,
-                        ss2.str(),
-                        augmented,
-                        i, r, -factor
-                    ));
+                    if (history.isRecording()) {
+                        std::stringstream ss2;
+                        ss2 << "将第 " << (r + 1) << " 行乘以 " << -factor << " 加到第 " << (i + 1) << " 行";
+                        history.addStep(
+                            OperationType::ADD_SCALED_ROW,
+                            ss2.str(),
+                            augmented,
+                            i, r, -factor
+                        );
+                    }
                 }
             }
         }
@@ -675,13 +1122,15 @@ Matrix MatrixOperations::inverseGaussJordan(const Matrix& mat, OperationHistory&
     // 从增广矩阵中提取右侧部分，即逆矩阵
     Matrix inverse = augmented.extractRightPart(n);
     
-    std::stringstream ss_final;
-    ss_final << "逆矩阵计算完成:";
-    history.addStep(OperationStep(
-        OperationType::RESULT_STATE,
-        ss_final.str(),
-        inverse
-    ));
+    if (history.isRecording()) {
+        std::stringstream ss_final;
+        ss_final << "逆矩阵计算完成:";
+        history.addStep(
+            OperationType::RESULT_STATE,
+            ss_final.str(),
+            inverse
+        );
+    }
     
     return inverse;
 }
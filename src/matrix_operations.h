@@ -3,8 +3,21 @@
 #include "operation_step.h"
 #include "determinant_expansion.h"
 
+// 新增：不记录步骤时使用的消元引擎
+enum class EliminationMode {
+    BAREISS,  // 无分数 Bareiss 消元（默认）：先逐行通分为整数矩阵，中间结果规模多项式有界
+    GAUSSIAN  // 传统有理数高斯消元
+};
+
 class MatrixOperations {
+private:
+    static EliminationMode eliminationMode;
+
 public:
+    // 新增：选择不记录步骤时的消元引擎（记录步骤时始终使用有理数消元，以便展示每一步）
+    static void setEliminationMode(EliminationMode mode);
+    static EliminationMode getEliminationMode();
+
     // 初等行变换方法 - 返回新矩阵
     static Matrix swapRows(const Matrix& mat, size_t row1, size_t row2);
     static Matrix scaleRow(const Matrix& mat, size_t row, const Fraction& scalar);
@@ -22,6 +35,9 @@ public:
     // 化简为最简行阶梯形（高斯-若尔当消元法）
     static Matrix toReducedRowEchelonForm(const Matrix& mat);
     static void toReducedRowEchelonForm(Matrix& mat, OperationHistory& history);
+    // 新增：只在前 pivotColLimit 列中选主元的最简行阶梯形，用于增广矩阵 [A|B]；pivotCols 返回各主元所在列。
+    // 秩以下各行的左侧全为 0，右侧保留消元后的值（可能相差非零倍数）
+    static Matrix toReducedRowEchelonForm(const Matrix& mat, size_t pivotColLimit, std::vector<size_t>& pivotCols);
     
     // 计算矩阵的秩
     static int rank(const Matrix& mat);
@@ -29,6 +45,11 @@ public:
     // 计算方阵的行列式
     static Fraction determinant(const Matrix& mat);
     static Fraction determinant(const Matrix& mat, OperationHistory& history);
+    // 新增：多模（中国剩余定理）行列式，适合较大的整数或有理数矩阵
+    static Fraction determinantModular(const Matrix& mat);
+    // 新增：特征多项式 det(xI - A) 的系数，第 k 项为 x^k 的系数（首一，共 n+1 项）。
+    // 通分为整数矩阵后用无除法的 Berkowitz 算法计算，不做多项式运算
+    static std::vector<Fraction> characteristicPolynomial(const Matrix& mat);
     
     // 新增：计算代数余子式矩阵
     static Matrix cofactorMatrix(const Matrix& mat);
@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// 零拷贝子矩阵视图：通过行、列下标映射引用原矩阵中的元素，
+// 余子式展开时用它代替 getSubMatrix 的整块复制。
+// MatrixT 只需提供 const 版本的 at(r, c)。
+template <typename MatrixT>
+class BasicMatrixView {
+public:
+    // 递归展开用的下标缓冲区。第 d 层子式使用 (rows-d) 个行下标和 (cols-d) 个列下标，
+    // 整个递归过程只在构造时分配一次。递归是深度优先的，同一层的兄弟子式依次复用同一块缓冲区。
+    class Workspace {
+    public:
+        Workspace(size_t rows, size_t cols)
+            : rows_(rows), cols_(cols),
+              rowBuf_(rows * (rows + 1) / 2 + 1),
+              colBuf_(cols * (cols + 1) / 2 + 1) {}
+
+        size_t* rowSlot(size_t depth) { return rowBuf_.data() + depth * rows_ - depth * (depth - 1) / 2; }
+        size_t* colSlot(size_t depth) { return colBuf_.data() + depth * cols_ - depth * (depth - 1) / 2; }
+
+    private:
+        size_t rows_, cols_;
+        std::vector<size_t> rowBuf_;
+        std::vector<size_t> colBuf_;
+    };
+
+    // 整个矩阵的视图，下标映射写入工作区的第 0 层
+    BasicMatrixView(const MatrixT& base, size_t rows, size_t cols, Workspace& ws)
+        : base_(&base), rowMap_(ws.rowSlot(0)), colMap_(ws.colSlot(0)),
+          rows_(rows), cols_(cols), depth_(0) {
+        size_t* rowOut = ws.rowSlot(0);
+        size_t* colOut = ws.colSlot(0);
+        for (size_t i = 0; i < rows; ++i) rowOut[i] = i;
+        for (size_t j = 0; j < cols; ++j) colOut[j] = j;
+    }
+
+    size_t rowCount() const { return rows_; }
+    size_t colCount() const { return cols_; }
+
+    decltype(auto) at(size_t r, size_t c) const { return base_->at(rowMap_[r], colMap_[c]); }
+
+    // 去掉第 excludeRow 行和第 excludeCol 列后的子式视图，下标写入工作区的下一层
+    BasicMatrixView minor(size_t excludeRow, size_t excludeCol, Workspace& ws) const {
+        size_t* rowOut = ws.rowSlot(depth_ + 1);
+        size_t* colOut = ws.colSlot(depth_ + 1);
+        size_t k = 0;
+        for (size_t i = 0; i < rows_; ++i) {
+            if (i != excludeRow) rowOut[k++] = rowMap_[i];
+        }
+        k = 0;
+        for (size_t j = 0; j < cols_; ++j) {
+            if (j != excludeCol) colOut[k++] = colMap_[j];
+        }
+        return BasicMatrixView(base_, rowOut, colOut, rows_ - 1, cols_ - 1, depth_ + 1);
+    }
+
+    // 把当前视图的下标映射复制到另一个工作区的第 0 层，得到不再依赖原工作区的等价视图，
+    // 可以交给其他线程独立递归。ws 需按当前视图的行数、列数构造
+    BasicMatrixView detach(Workspace& ws) const {
+        size_t* rowOut = ws.rowSlot(0);
+        size_t* colOut = ws.colSlot(0);
+        for (size_t i = 0; i < rows_; ++i) rowOut[i] = rowMap_[i];
+        for (size_t j = 0; j < cols_; ++j) colOut[j] = colMap_[j];
+        return BasicMatrixView(base_, rowOut, colOut, rows_, cols_, 0);
+    }
+
+private:
+    BasicMatrixView(const MatrixT* base, const size_t* rowMap, const size_t* colMap,
+                    size_t rows, size_t cols, size_t depth)
+        : base_(base), rowMap_(rowMap), colMap_(colMap), rows_(rows), cols_(cols), depth_(depth) {}
+
+    const MatrixT* base_;
+    const size_t* rowMap_;
+    const size_t* colMap_;
+    size_t rows_, cols_;
+    size_t depth_;
+};
@@ -0,0 +1,561 @@
+#include "modular_arithmetic.h"
+#include "task_scheduler.h"
+#include "cancellation.h"
+#include "progress.h"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <boost/multiprecision/integer.hpp>
+
+uint64_t PrimeField::pow(uint64_t base, uint64_t exp) const {
+    uint64_t result = 1 % p;
+    base %= p;
+    while (exp > 0) {
+        if (exp & 1) {
+            result = mul(result, base);
+        }
+        base = mul(base, base);
+        exp >>= 1;
+    }
+    return result;
+}
+
+uint64_t PrimeField::inv(uint64_t a) const {
+    if (a % p == 0) {
+        throw std::runtime_error("Zero has no modular inverse");
+    }
+    return pow(a, p - 2); // 费马小定理
+}
+
+uint64_t PrimeField::reduce(const BigInt& x) const {
+    BigInt r = x % p;
+    if (r < 0) {
+        r += p;
+    }
+    return r.convert_to<uint64_t>();
+}
+
+void CrtAccumulator::add(uint64_t residue, const PrimeField& field) {
+    // Garner：x' = x + M * ((r - x) * M^{-1} mod p)
+    uint64_t current = field.reduce(value);
+    uint64_t t = field.mul(field.sub(residue % field.modulus(), current), field.inv(field.reduce(mod)));
+    value += mod * t;
+    mod *= field.modulus();
+}
+
+BigInt CrtAccumulator::symmetricValue() const {
+    if (value * 2 > mod) {
+        return value - mod;
+    }
+    return value;
+}
+
+bool ModularOperations::isPrime(uint64_t n) {
+    if (n < 2) {
+        return false;
+    }
+    for (uint64_t small : {2ULL, 3ULL, 5ULL, 7ULL, 11ULL, 13ULL, 17ULL, 19ULL, 23ULL, 29ULL, 31ULL, 37ULL}) {
+        if (n % small == 0) {
+            return n == small;
+        }
+    }
+    uint64_t d = n - 1;
+    int s = 0;
+    while ((d & 1) == 0) {
+        d >>= 1;
+        ++s;
+    }
+    PrimeField field(n);
+    // 这组底数对所有 64 位整数都是确定性的
+    for (uint64_t a : {2ULL, 325ULL, 9375ULL, 28178ULL, 450775ULL, 9780504ULL, 1795265022ULL}) {
+        a %= n;
+        if (a == 0) {
+            continue;
+        }
+        uint64_t x = field.pow(a, d);
+        if (x == 1 || x == n - 1) {
+            continue;
+        }
+        bool composite = true;
+        for (int i = 1; i < s; ++i) {
+            x = field.mul(x, x);
+            if (x == n - 1) {
+                composite = false;
+                break;
+            }
+        }
+        if (composite) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint64_t> ModularOperations::primes(size_t count) {
+    static std::vector<uint64_t> cache;
+    static std::mutex cacheMutex;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    uint64_t candidate = cache.empty() ? (1ULL << 62) - 1 : cache.back() - 2;
+    while (cache.size() < count) {
+        if (isPrime(candidate)) {
+            cache.push_back(candidate);
+        }
+        candidate -= 2;
+    }
+    return std::vector<uint64_t>(cache.begin(), cache.begin() + count);
+}
+
+std::vector<uint64_t> ModularOperations::nttPrimes(size_t count) {
+    static std::vector<uint64_t> cache;
+    static std::mutex cacheMutex;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    uint64_t k = cache.empty() ? (1ULL << 30) - 1 : (cache.back() >> 32) - 1;
+    while (cache.size() < count) {
+        uint64_t candidate = (k << 32) + 1;
+        if (isPrime(candidate)) {
+            cache.push_back(candidate);
+        }
+        --k;
+    }
+    return std::vector<uint64_t>(cache.begin(), cache.begin() + count);
+}
+
+// p = k * 2^32 + 1 下阶恰为 2^32 的单位根：a^k 的阶整除 2^32，a^(k * 2^31) != 1 时恰为 2^32
+static uint64_t nttRoot(const PrimeField& field) {
+    const uint64_t k = (field.modulus() - 1) >> 32;
+    for (uint64_t a = 2;; ++a) {
+        uint64_t w = field.pow(a, k);
+        if (field.pow(w, 1ULL << 31) != 1) {
+            return w;
+        }
+    }
+}
+
+void ModularOperations::ntt(std::vector<uint64_t>& a, const PrimeField& field, bool inverse) {
+    const size_t n = a.size();
+    if (n <= 1) {
+        return;
+    }
+    if ((n & (n - 1)) != 0 || n > (1ULL << 32)) {
+        throw std::invalid_argument("ntt expects a power-of-two length not exceeding 2^32");
+    }
+    // 位逆序置换
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(a[i], a[j]);
+        }
+    }
+
+    uint64_t root = nttRoot(field);
+    if (inverse) {
+        root = field.inv(root);
+    }
+    std::vector<uint64_t> twiddle(n / 2);
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        const uint64_t step = field.pow(root, (1ULL << 32) / len);
+        twiddle[0] = 1;
+        for (size_t j = 1; j < half; ++j) {
+            twiddle[j] = field.mul(twiddle[j - 1], step);
+        }
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; ++j) {
+                uint64_t u = a[i + j];
+                uint64_t v = field.mul(a[i + j + half], twiddle[j]);
+                a[i + j] = field.add(u, v);
+                a[i + j + half] = field.sub(u, v);
+            }
+        }
+    }
+    if (inverse) {
+        const uint64_t scale = field.inv(static_cast<uint64_t>(n));
+        for (auto& x : a) {
+            x = field.mul(x, scale);
+        }
+    }
+}
+
+std::vector<uint64_t> ModularOperations::multiplyModP(std::vector<uint64_t> a, std::vector<uint64_t> b, const PrimeField& field) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+    const size_t resultSize = a.size() + b.size() - 1;
+    size_t n = 1;
+    while (n < resultSize) {
+        n <<= 1;
+    }
+    a.resize(n, 0);
+    b.resize(n, 0);
+    ntt(a, field, false);
+    ntt(b, field, false);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = field.mul(a[i], b[i]);
+    }
+    ntt(a, field, true);
+    a.resize(resultSize);
+    return a;
+}
+
+std::vector<BigInt> ModularOperations::integerPolynomialProduct(const std::vector<BigInt>& a, const std::vector<BigInt>& b) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+    BigInt maxA = 0, maxB = 0;
+    for (const auto& x : a) {
+        maxA = std::max(maxA, BigInt(abs(x)));
+    }
+    for (const auto& x : b) {
+        maxB = std::max(maxB, BigInt(abs(x)));
+    }
+    const size_t resultSize = a.size() + b.size() - 1;
+    if (maxA == 0 || maxB == 0) {
+        return std::vector<BigInt>(resultSize, BigInt(0));
+    }
+
+    // 模数 M > 2 * 系数界时，对称剩余唯一确定各系数
+    const BigInt limit = maxA * maxB * std::min(a.size(), b.size()) * 2;
+    const unsigned primeBits = 61; // 每个 NTT 素数都大于 2^61
+    const size_t count = boost::multiprecision::msb(limit) / primeBits + 1;
+    const std::vector<uint64_t> moduli = nttPrimes(count);
+
+    std::vector<std::vector<uint64_t>> residues(count);
+    TaskScheduler::parallelFor(0, count, [&](size_t k) {
+        Cancellation::checkpoint();
+        PrimeField field(moduli[k]);
+        residues[k] = multiplyModP(reduceMatrix(a, field), reduceMatrix(b, field), field);
+    });
+
+    std::vector<BigInt> result(resultSize);
+    TaskScheduler::parallelFor(0, resultSize, [&](size_t i) {
+        CrtAccumulator crt;
+        for (size_t k = 0; k < count; ++k) {
+            crt.add(residues[k][i], PrimeField(moduli[k]));
+        }
+        result[i] = crt.symmetricValue();
+    });
+    return result;
+}
+
+std::vector<uint64_t> ModularOperations::reduceMatrix(const std::vector<BigInt>& entries, const PrimeField& field) {
+    std::vector<uint64_t> result(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        result[i] = field.reduce(entries[i]);
+    }
+    return result;
+}
+
+uint64_t ModularOperations::determinantModP(std::vector<uint64_t>& a, size_t n, const PrimeField& field) {
+    uint64_t det = 1;
+    for (size_t c = 0; c < n; ++c) {
+        size_t pivotRow = c;
+        while (pivotRow < n && a[pivotRow * n + c] == 0) {
+            ++pivotRow;
+        }
+        if (pivotRow == n) {
+            return 0;
+        }
+        if (pivotRow != c) {
+            std::swap_ranges(a.begin() + c * n, a.begin() + (c + 1) * n, a.begin() + pivotRow * n);
+            det = field.neg(det);
+        }
+
+        const uint64_t* pivotRowData = a.data() + c * n;
+        det = field.mul(det, pivotRowData[c]);
+        uint64_t pivotInv = field.inv(pivotRowData[c]);
+        for (size_t i = c + 1; i < n; ++i) {
+            uint64_t* row = a.data() + i * n;
+            if (row[c] == 0) {
+                continue;
+            }
+            uint64_t factor = field.mul(row[c], pivotInv);
+            for (size_t j = c + 1; j < n; ++j) {
+                row[j] = field.sub(row[j], field.mul(factor, pivotRowData[j]));
+            }
+            row[c] = 0;
+        }
+    }
+    return det;
+}
+
+bool ModularOperations::inverseModP(std::vector<uint64_t>& a, size_t n, const PrimeField& field, std::vector<uint64_t>& inverse) {
+    inverse.assign(n * n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        inverse[i * n + i] = 1;
+    }
+    for (size_t c = 0; c < n; ++c) {
+        size_t pivotRow = c;
+        while (pivotRow < n && a[pivotRow * n + c] == 0) {
+            ++pivotRow;
+        }
+        if (pivotRow == n) {
+            return false;
+        }
+        if (pivotRow != c) {
+            std::swap_ranges(a.begin() + c * n, a.begin() + (c + 1) * n, a.begin() + pivotRow * n);
+            std::swap_ranges(inverse.begin() + c * n, inverse.begin() + (c + 1) * n, inverse.begin() + pivotRow * n);
+        }
+
+        uint64_t* pivotA = a.data() + c * n;
+        uint64_t* pivotInv = inverse.data() + c * n;
+        uint64_t scale = field.inv(pivotA[c]);
+        for (size_t j = c; j < n; ++j) {
+            pivotA[j] = field.mul(pivotA[j], scale);
+        }
+        for (size_t j = 0; j < n; ++j) {
+            pivotInv[j] = field.mul(pivotInv[j], scale);
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t* rowA = a.data() + i * n;
+            uint64_t factor = rowA[c];
+            if (i == c || factor == 0) {
+                continue;
+            }
+            uint64_t* rowInv = inverse.data() + i * n;
+            for (size_t j = c; j < n; ++j) {
+                rowA[j] = field.sub(rowA[j], field.mul(factor, pivotA[j]));
+            }
+            for (size_t j = 0; j < n; ++j) {
+                rowInv[j] = field.sub(rowInv[j], field.mul(factor, pivotInv[j]));
+            }
+        }
+    }
+    return true;
+}
+
+bool ModularOperations::rationalReconstruction(const BigInt& u, const BigInt& m, const BigInt& bound, BigInt& num, BigInt& den) {
+    // 扩展欧几里得算法进行到余数不超过 bound 为止
+    BigInt r0 = m;
+    BigInt r1 = u % m;
+    if (r1 < 0) {
+        r1 += m;
+    }
+    BigInt t0 = 0;
+    BigInt t1 = 1;
+    while (r1 > bound) {
+        BigInt q = r0 / r1;
+        r0 -= q * r1;
+        r0.swap(r1);
+        t0 -= q * t1;
+        t0.swap(t1);
+    }
+    if (t1 == 0 || abs(t1) > bound) {
+        return false;
+    }
+    if (t1 < 0) {
+        r1 = -r1;
+        t1 = -t1;
+    }
+    if (boost::multiprecision::gcd(r1, t1) != 1) {
+        return false;
+    }
+    num = r1;
+    den = t1;
+    return true;
+}
+
+BigInt ModularOperations::hadamardBound(const std::vector<BigInt>& entries, size_t n) {
+    BigInt boundSquared = 1;
+    for (size_t i = 0; i < n; ++i) {
+        BigInt rowNormSquared = 0;
+        for (size_t j = 0; j < n; ++j) {
+            const BigInt& x = entries[i * n + j];
+            rowNormSquared += x * x;
+        }
+        if (rowNormSquared == 0) {
+            return 0;
+        }
+        boundSquared *= rowNormSquared;
+    }
+    BigInt bound = boost::multiprecision::sqrt(boundSquared);
+    if (bound * bound < boundSquared) {
+        ++bound;
+    }
+    return bound;
+}
+
+BigInt ModularOperations::integerDeterminant(const std::vector<BigInt>& entries, size_t n, bool earlyTermination) {
+    if (n == 0) {
+        return 1;
+    }
+    if (entries.size() != n * n) {
+        throw std::invalid_argument("integerDeterminant expects an n x n matrix");
+    }
+    BigInt bound = hadamardBound(entries, n);
+    if (bound == 0) {
+        return 0;
+    }
+
+    // 模数 M > 2H 时，对称剩余唯一确定 det
+    const BigInt limit = bound * 2;
+    const unsigned primeBits = 61; // 每个素数都大于 2^61
+    const size_t batchSize = std::max(2, TaskScheduler::threadCount());
+
+    CrtAccumulator crt;
+    size_t used = 0;
+    BigInt previous;
+    bool havePrevious = false;
+    // 按 Hadamard 界估计所需素数个数，仅用于进度显示（提前终止时会更少）
+    const size_t estimatedPrimes = boost::multiprecision::msb(limit) / primeBits + 1;
+    while (crt.modulus() <= limit) {
+        size_t bitsMissing = boost::multiprecision::msb(limit) + 1 - boost::multiprecision::msb(crt.modulus());
+        size_t count = std::min(batchSize, bitsMissing / primeBits + 1);
+        std::vector<uint64_t> batch = primes(used + count);
+        std::vector<uint64_t> residues(count);
+
+        TaskScheduler::parallelFor(0, count, [&](size_t k) {
+            Cancellation::checkpoint();
+            PrimeField field(batch[used + k]);
+            std::vector<uint64_t> a = reduceMatrix(entries, field);
+            residues[k] = determinantModP(a, n, field);
+        });
+
+        for (size_t k = 0; k < count; ++k) {
+            crt.add(residues[k], PrimeField(batch[used + k]));
+        }
+        used += count;
+        Progress::report("多模行列式: 素数", used, std::max(used, estimatedPrimes));
+
+        BigInt current = crt.symmetricValue();
+        if (earlyTermination && havePrevious && count >= 2 && current == previous) {
+            break;
+        }
+        previous = current;
+        havePrevious = true;
+    }
+    return crt.symmetricValue();
+}
+
+// 对 p-adic 展开 X (mod modulus) 逐个分量做有理重构。分量先乘以已得到的公分母，
+// 后面的分量通常只剩很小的分母需要重构。成功时解写成 numerators / denominator
+static bool reconstructSolution(const std::vector<BigInt>& X, const BigInt& modulus,
+                                std::vector<BigInt>& numerators, BigInt& denominator) {
+    const size_t n = X.size();
+    const BigInt bound = boost::multiprecision::sqrt(BigInt(modulus / 2));
+    std::vector<BigInt> componentDen(n);
+    numerators.assign(n, 0);
+    denominator = 1;
+    for (size_t j = 0; j < n; ++j) {
+        BigInt num, den;
+        if (!ModularOperations::rationalReconstruction(BigInt(X[j] * denominator % modulus), modulus, bound, num, den)) {
+            return false;
+        }
+        // x_j = num / (denominator * den)
+        numerators[j] = num;
+        denominator *= den;
+        componentDen[j] = denominator;
+    }
+    for (size_t j = 0; j < n; ++j) {
+        if (componentDen[j] != denominator) {
+            numerators[j] *= denominator / componentDen[j];
+        }
+    }
+    return true;
+}
+
+bool ModularOperations::solveNonsingular(const std::vector<BigInt>& A, const std::vector<BigInt>& b, size_t n,
+                                         std::vector<BigInt>& numerators, BigInt& denominator) {
+    if (A.size() != n * n || b.size() != n) {
+        throw std::invalid_argument("solveNonsingular expects an n x n matrix and a length-n vector");
+    }
+    if (n == 0) {
+        numerators.clear();
+        denominator = 1;
+        return true;
+    }
+
+    // 在素数 p 下求 A 的逆；p 整除 det(A) 的概率极小，换几个素数仍奇异就认为 A 奇异
+    std::vector<uint64_t> inverse;
+    uint64_t p = 0;
+    for (uint64_t candidate : primes(3)) {
+        PrimeField field(candidate);
+        std::vector<uint64_t> a = reduceMatrix(A, field);
+        if (inverseModP(a, n, field, inverse)) {
+            p = candidate;
+            break;
+        }
+    }
+    if (p == 0) {
+        return false;
+    }
+    const PrimeField field(p);
+
+    // 由 Cramer 法则，解的分子和分母都是 [A|b] 的 n 阶子式，按行范数之积统一取界 B，
+    // p^k > 2B^2 时有理重构必然成功
+    BigInt boundSquared = 1;
+    for (size_t i = 0; i < n; ++i) {
+        BigInt rowNormSquared = b[i] * b[i];
+        for (size_t j = 0; j < n; ++j) {
+            rowNormSquared += A[i * n + j] * A[i * n + j];
+        }
+        boundSquared *= rowNormSquared;
+    }
+    const BigInt limit = boundSquared * 2 + 1;
+
+    // 不变式：b = A * X + p^k * residual
+    std::vector<BigInt> residual(b);
+    std::vector<BigInt> X(n, BigInt(0));
+    std::vector<uint64_t> residualModP(n), digit(n);
+    BigInt pk = 1;
+    BigInt sum;
+    size_t step = 0;
+    size_t nextCheck = 2;
+    while (true) {
+        for (size_t i = 0; i < n; ++i) {
+            residualModP[i] = field.reduce(residual[i]);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t* row = inverse.data() + i * n;
+            uint64_t acc = 0;
+            for (size_t j = 0; j < n; ++j) {
+                acc = field.add(acc, field.mul(row[j], residualModP[j]));
+            }
+            digit[i] = acc;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            sum = residual[i];
+            for (size_t j = 0; j < n; ++j) {
+                if (digit[j] != 0) {
+                    sum -= A[i * n + j] * digit[j];
+                }
+            }
+            residual[i] = sum / p; // 整除
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (digit[i] != 0) {
+                X[i] += pk * digit[i];
+            }
+        }
+        pk *= p;
+        ++step;
+
+        // 在步数翻倍时和达到上界时尝试重构，并用 A * x = b 精确验证，解较小时可以提前结束
+        bool atBound = pk > limit;
+        if (atBound || step == nextCheck) {
+            nextCheck *= 2;
+            if (reconstructSolution(X, pk, numerators, denominator)) {
+                bool verified = true;
+                for (size_t i = 0; i < n && verified; ++i) {
+                    sum = 0;
+                    for (size_t j = 0; j < n; ++j) {
+                        sum += A[i * n + j] * numerators[j];
+                    }
+                    verified = (sum == denominator * b[i]);
+                }
+                if (verified) {
+                    return true;
+                }
+            }
+            if (atBound) {
+                throw std::runtime_error("Dixon lifting failed to reconstruct the solution");
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "fraction.h"
+
+// 单个素数 p (< 2^62) 下的字长模运算，乘法借助 128 位中间结果。
+// 多模算法中每个素数上的计算都只用机器字，不产生大整数。
+class PrimeField {
+public:
+    explicit PrimeField(uint64_t p) : p(p) {}
+
+    uint64_t modulus() const { return p; }
+
+    uint64_t add(uint64_t a, uint64_t b) const {
+        uint64_t s = a + b;
+        return s >= p ? s - p : s;
+    }
+    uint64_t sub(uint64_t a, uint64_t b) const { return a >= b ? a - b : a + (p - b); }
+    uint64_t neg(uint64_t a) const { return a == 0 ? 0 : p - a; }
+    uint64_t mul(uint64_t a, uint64_t b) const {
+        return static_cast<uint64_t>(static_cast<unsigned __int128>(a) * b % p);
+    }
+    uint64_t pow(uint64_t base, uint64_t exp) const;
+    uint64_t inv(uint64_t a) const; // a 不能为 0
+
+    // 把大整数约化到 [0, p)
+    uint64_t reduce(const BigInt& x) const;
+
+private:
+    uint64_t p;
+};
+
+// 增量式中国剩余定理重构：依次加入 x mod p_i，维护 x mod (p_1 * ... * p_k)
+class CrtAccumulator {
+public:
+    void add(uint64_t residue, const PrimeField& field);
+
+    const BigInt& modulus() const { return mod; }
+    // 对称剩余，取值范围 (-M/2, M/2]
+    BigInt symmetricValue() const;
+
+private:
+    BigInt value = 0;
+    BigInt mod = 1;
+};
+
+class ModularOperations {
+public:
+    // 2^62 以下从大到小的前 count 个素数，生成一次后缓存
+    static std::vector<uint64_t> primes(size_t count);
+
+    // 形如 k * 2^32 + 1 的素数（2^61 < p < 2^62），从大到小的前 count 个，生成一次后缓存。
+    // 这类素数下存在 2^32 次单位根，可做长度不超过 2^32 的数论变换
+    static std::vector<uint64_t> nttPrimes(size_t count);
+
+    // 64 位整数的确定性 Miller-Rabin 素性测试
+    static bool isPrime(uint64_t n);
+
+    // 把行主序的整数矩阵逐元素约化到模 p
+    static std::vector<uint64_t> reduceMatrix(const std::vector<BigInt>& entries, const PrimeField& field);
+
+    // 模 p 高斯消元求 n 阶方阵的行列式，a 会被原地修改
+    static uint64_t determinantModP(std::vector<uint64_t>& a, size_t n, const PrimeField& field);
+
+    // 模 p 高斯-若尔当消元求逆，a 会被原地修改；a 在模 p 下奇异时返回 false
+    static bool inverseModP(std::vector<uint64_t>& a, size_t n, const PrimeField& field, std::vector<uint64_t>& inverse);
+
+    // 数论变换：a 的长度须为 2 的幂，field 的模数须来自 nttPrimes。
+    // 正变换把系数向量变为在各个单位根处的值，inverse 为 true 时做逆变换（插值）
+    static void ntt(std::vector<uint64_t>& a, const PrimeField& field, bool inverse);
+
+    // 模 p 多项式乘法（系数按升幂排列），用数论变换求值、逐点相乘、再插值
+    static std::vector<uint64_t> multiplyModP(std::vector<uint64_t> a, std::vector<uint64_t> b, const PrimeField& field);
+
+    // 多模整系数多项式乘法：按 |c_k| <= min(len) * max|a_i| * max|b_j| 取足够多的 NTT 素数，
+    // 在各素数上并行做模乘法，再用中国剩余定理逐个系数重构
+    static std::vector<BigInt> integerPolynomialProduct(const std::vector<BigInt>& a, const std::vector<BigInt>& b);
+
+    // 有理重构：求满足 num ≡ den * u (mod m)、|num| <= bound、0 < den <= bound 的既约分数
+    static bool rationalReconstruction(const BigInt& u, const BigInt& m, const BigInt& bound, BigInt& num, BigInt& den);
+
+    // Hadamard 界：|det A| <= 各行欧氏范数之积（向上取整）
+    static BigInt hadamardBound(const std::vector<BigInt>& entries, size_t n);
+
+    // 多模行列式：在若干素数上并行求模行列式，再用中国剩余定理重构。
+    // 模数超过 2 倍 Hadamard 界时结果必然正确；earlyTermination 为 true 时，
+    // 若加入一整批新素数后重构值不变则提前结束（出错概率约为 2^-120）。
+    static BigInt integerDeterminant(const std::vector<BigInt>& entries, size_t n, bool earlyTermination = true);
+
+    // Dixon p-adic 提升求解整数方程组 A x = b（A 为 n 阶方阵，行主序）：
+    // 只在一个素数下求一次逆，之后每步只做字长矩阵向量乘法，最后用有理重构还原解。
+    // 解表示为 numerators / denominator；A 在候选素数下都奇异时返回 false
+    static bool solveNonsingular(const std::vector<BigInt>& A, const std::vector<BigInt>& b, size_t n,
+                                 std::vector<BigInt>& numerators, BigInt& denominator);
+};
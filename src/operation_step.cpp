@@ -1,4 +1,5 @@
 #include "operation_step.h"
+#include <algorithm>
 
 OperationStep::OperationStep(OperationType type, const std::string& desc, const Matrix& matrix, 
                             int r1, int r2, const Fraction& scalar)
@@ -18,19 +19,143 @@ void OperationStep::print(std::ostream& os) const {
 }
 
 // OperationHistory 实现
+OperationHistory::OperationHistory()
+    : tail(0, 0), hasTail(false), opsSinceCheckpoint(0),
+      cachedState(0, 0), cachedIndex(0), hasCache(false) {}
+
+bool OperationHistory::isRowOperation(OperationType type) {
+    return type == OperationType::SWAP_ROWS || type == OperationType::SCALE_ROW ||
+           type == OperationType::ADD_SCALED_ROW;
+}
+
+void OperationHistory::applyRowOperation(Matrix& mat, const StepRecord& record) {
+    size_t cols = mat.colCount();
+    switch (record.type) {
+        case OperationType::SWAP_ROWS:
+            mat.swapRows(record.row1, record.row2);
+            break;
+        case OperationType::SCALE_ROW: {
+            Fraction* row = mat.rowData(record.row1);
+            for (size_t j = 0; j < cols; ++j) {
+                if (row[j] != Fraction(0)) {
+                    row[j] = row[j] * record.scalar;
+                }
+            }
+            break;
+        }
+        case OperationType::ADD_SCALED_ROW: {
+            Fraction* target = mat.rowData(record.row1);
+            const Fraction* source = mat.rowData(record.row2);
+            for (size_t j = 0; j < cols; ++j) {
+                if (source[j] != Fraction(0)) {
+                    target[j] = RationalAccumulator(target[j]).fma(source[j], record.scalar).result();
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// 重放一次行变换只涉及一行（colCount 个元素），间隔取行数时，
+// 从检查点重放的开销与复制一个完整矩阵相当，而检查点的总量只有逐步快照的 1/行数
+size_t OperationHistory::checkpointInterval() const {
+    return std::max<size_t>(8, tail.rowCount());
+}
+
 void OperationHistory::addStep(const OperationStep& step) {
-    steps.push_back(step);
+    addStep(step.getType(), step.getDescription(), step.getMatrixState(),
+            step.getRow1(), step.getRow2(), step.getScalar());
+}
+
+void OperationHistory::addStep(OperationType type, const std::string& desc, const Matrix& matrix,
+                               int r1, int r2, const Fraction& scalar) {
+    StepRecord record{type, desc, r1, r2, scalar, nullptr};
+    bool sameShape = hasTail && tail.rowCount() == matrix.rowCount() && tail.colCount() == matrix.colCount();
+
+    if (isRowOperation(type) && sameShape && r1 >= 0 && static_cast<size_t>(r1) < matrix.rowCount() &&
+        (type == OperationType::SCALE_ROW || (r2 >= 0 && static_cast<size_t>(r2) < matrix.rowCount()))) {
+        // 只比较被修改的行，确认该步确实是在上一状态上做的这次行变换
+        applyRowOperation(tail, record);
+        bool replayable = std::equal(tail.rowData(r1), tail.rowData(r1) + tail.colCount(), matrix.rowData(r1));
+        if (replayable && type == OperationType::SWAP_ROWS) {
+            replayable = std::equal(tail.rowData(r2), tail.rowData(r2) + tail.colCount(), matrix.rowData(r2));
+        }
+        if (replayable) {
+            if (++opsSinceCheckpoint >= checkpointInterval()) {
+                record.checkpoint = std::make_shared<const Matrix>(tail);
+                opsSinceCheckpoint = 0;
+            }
+            steps.push_back(std::move(record));
+            return;
+        }
+    } else if (!isRowOperation(type) && sameShape) {
+        // 说明性步骤（如“主元加入计算”）的矩阵往往与上一状态相同，不必再保存一份
+        bool unchanged = true;
+        for (size_t i = 0; i < matrix.rowCount() && unchanged; ++i) {
+            unchanged = std::equal(tail.rowData(i), tail.rowData(i) + tail.colCount(), matrix.rowData(i));
+        }
+        if (unchanged) {
+            steps.push_back(std::move(record));
+            return;
+        }
+    }
+
+    // 保存完整快照，并以它作为后续行变换的起点
+    tail = matrix;
+    hasTail = true;
+    opsSinceCheckpoint = 0;
+    record.checkpoint = std::make_shared<const Matrix>(matrix);
+    steps.push_back(std::move(record));
 }
 
 size_t OperationHistory::size() const {
     return steps.size();
 }
 
-const OperationStep& OperationHistory::getStep(size_t index) const {
+Matrix OperationHistory::rebuildState(size_t index) const {
+    size_t start = index;
+    while (!steps[start].checkpoint) {
+        --start; // 第一步总是快照，循环必然终止
+    }
+
+    Matrix state(0, 0);
+    if (hasCache && cachedIndex >= start && cachedIndex <= index) {
+        state = cachedState;
+        start = cachedIndex;
+    } else {
+        state = *steps[start].checkpoint;
+    }
+    for (size_t k = start + 1; k <= index; ++k) {
+        if (isRowOperation(steps[k].type)) {
+            applyRowOperation(state, steps[k]);
+        }
+    }
+
+    cachedState = state;
+    cachedIndex = index;
+    hasCache = true;
+    return state;
+}
+
+OperationStep OperationHistory::getStep(size_t index) const {
     if (index >= steps.size()) {
         throw std::out_of_range("Step index out of range");
     }
-    return steps[index];
+    const StepRecord& record = steps[index];
+    return OperationStep(record.type, record.description, rebuildState(index),
+                         record.row1, record.row2, record.scalar);
+}
+
+size_t OperationHistory::storedMatrixCount() const {
+    size_t count = 0;
+    for (const auto& record : steps) {
+        if (record.checkpoint) {
+            ++count;
+        }
+    }
+    return count;
 }
 
 void OperationHistory::printAll(std::ostream& os) const {
@@ -41,7 +166,7 @@ void OperationHistory::printAll(std::ostream& os) const {
 
     for (size_t i = 0; i < steps.size(); ++i) {
         os << "Step " << i << ": ";
-        steps[i].print(os);
+        getStep(i).print(os);
     }
 }
 
@@ -52,9 +177,95 @@ void OperationHistory::printStep(size_t index, std::ostream& os) const {
     }
 
     os << "Step " << index << ": ";
-    steps[index].print(os);
+    getStep(index).print(os);
 }
 
 void OperationHistory::clear() {
     steps.clear();
+    tail = Matrix(0, 0);
+    hasTail = false;
+    opsSinceCheckpoint = 0;
+    cachedState = Matrix(0, 0);
+    hasCache = false;
+}
+
+// StepStream 实现
+StepStream::StepStream()
+    : streaming(false), closed(true), cancelled(false), window(0), consumed(0) {}
+
+void StepStream::addStep(OperationType type, const std::string& desc, const Matrix& matrix,
+                         int r1, int r2, const Fraction& scalar) {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return !streaming || cancelled || size() < consumed + window; });
+    if (cancelled) {
+        return;
+    }
+    OperationHistory::addStep(type, desc, matrix, r1, r2, scalar);
+    changed.notify_all();
+}
+
+void StepStream::open(size_t window) {
+    std::lock_guard<std::mutex> lock(mutex);
+    OperationHistory::clear();
+    streaming = true;
+    closed = false;
+    cancelled = false;
+    this->window = std::max<size_t>(1, window);
+    consumed = 0;
+}
+
+void StepStream::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    streaming = false;
+    changed.notify_all();
+}
+
+void StepStream::cancel() {
+    std::lock_guard<std::mutex> lock(mutex);
+    cancelled = true;
+    changed.notify_all();
+}
+
+bool StepStream::waitForStep(size_t index) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (consumed < index + 1) {
+        consumed = index + 1;
+        changed.notify_all();
+    }
+    changed.wait(lock, [this, index] { return closed || size() > index; });
+    return size() > index;
+}
+
+bool StepStream::waitForStep(size_t index, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (consumed < index + 1) {
+        consumed = index + 1;
+        changed.notify_all();
+    }
+    changed.wait_for(lock, timeout, [this, index] { return closed || size() > index; });
+    return size() > index;
+}
+
+bool StepStream::isClosed() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return closed;
+}
+
+size_t StepStream::availableSteps() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return size();
+}
+
+OperationStep StepStream::stepAt(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return getStep(index);
+}
+
+void StepStream::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (streaming) {
+        return;
+    }
+    OperationHistory::clear();
 }
@@ -1,6 +1,10 @@
 #pragma once
 #include <string>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include "matrix.h"
 
 enum class OperationType {
@@ -37,19 +41,56 @@ public:
 };
 
 // 操作历史管理类
+// 行变换步骤只记录操作本身（类型、行号、系数），矩阵状态在 getStep 时从最近的检查点重放得到。
+// 完整矩阵只在以下情况保存：初始/结果等非行变换状态、无法由上一状态重放得到的步骤，
+// 以及每隔 checkpointInterval() 次行变换保存一次检查点，保证随机访问时的重放长度有界。
 class OperationHistory {
 private:
-    std::vector<OperationStep> steps;
+    struct StepRecord {
+        OperationType type;
+        std::string description;
+        int row1, row2;
+        Fraction scalar;
+        std::shared_ptr<const Matrix> checkpoint; // 非空时即为该步之后的矩阵状态
+    };
+    std::vector<StepRecord> steps;
+
+    // 记录过程中的最新矩阵状态，用于校验行变换能否重放以及生成检查点
+    Matrix tail;
+    bool hasTail;
+    size_t opsSinceCheckpoint;
+
+    // 最近一次重建的状态，顺序前进浏览时只需重放一步
+    mutable Matrix cachedState;
+    mutable size_t cachedIndex;
+    mutable bool hasCache;
+
+    static bool isRowOperation(OperationType type);
+    static void applyRowOperation(Matrix& mat, const StepRecord& record);
+    size_t checkpointInterval() const;
+    Matrix rebuildState(size_t index) const;
 
 public:
+    OperationHistory();
+    virtual ~OperationHistory() = default;
+
     // 添加操作步骤
-    void addStep(const OperationStep& step);
+    virtual void addStep(const OperationStep& step);
+    // 新增：直接引用矩阵记录步骤，省去先构造 OperationStep 时的整块复制
+    virtual void addStep(OperationType type, const std::string& desc, const Matrix& matrix,
+                         int r1 = -1, int r2 = -1, const Fraction& scalar = Fraction(1));
+
+    // 新增：是否真正记录步骤。返回 false 时调用方应跳过步骤描述的格式化和矩阵快照
+    virtual bool isRecording() const { return true; }
     
     // 获取步骤数量
     size_t size() const;
     
-    // 获取指定索引的步骤
-    const OperationStep& getStep(size_t index) const;
+    // 获取指定索引的步骤（矩阵状态按需重建）
+    OperationStep getStep(size_t index) const;
+
+    // 新增：实际保存的完整矩阵个数
+    size_t storedMatrixCount() const;
     
     // 打印所有步骤
     void printAll(std::ostream& os = std::cout) const;
@@ -60,3 +101,52 @@ public:
     // 清空历史
     void clear();
 };
+
+// 新增：不记录任何步骤的空历史，供不显示步骤的计算复用带历史记录的算法实现
+class NullOperationHistory : public OperationHistory {
+public:
+    void addStep(const OperationStep&) override {}
+    void addStep(OperationType, const std::string&, const Matrix&, int, int, const Fraction&) override {}
+    bool isRecording() const override { return false; }
+};
+
+// 新增：边计算边浏览的步骤流。
+// 计算在后台线程中向流中写入步骤，步骤展示模式按需拉取；open() 之后生产者最多领先
+// 消费者 window 步，超出时阻塞等待，因此已生成但未浏览的步骤数有界。
+// 未调用 open() 时行为与 OperationHistory 相同，不会阻塞。
+class StepStream : public OperationHistory {
+public:
+    StepStream();
+
+    using OperationHistory::addStep;
+    void addStep(OperationType type, const std::string& desc, const Matrix& matrix,
+                 int r1 = -1, int r2 = -1, const Fraction& scalar = Fraction(1)) override;
+    bool isRecording() const override { return !cancelled; }
+
+    // 清空步骤并进入流式模式
+    void open(size_t window);
+    // 生产者结束（无论成功还是异常），唤醒等待的消费者
+    void close();
+    // 消费者放弃浏览：生产者不再阻塞，后续步骤也不再记录
+    void cancel();
+
+    // 阻塞直到第 index 步可用或流已关闭，返回该步是否可用；同时允许生产者继续向前生成
+    bool waitForStep(size_t index);
+    // 同上，但最多等待 timeout；超时或流已关闭时返回 false，调用方可在两次等待之间处理按键
+    bool waitForStep(size_t index, std::chrono::milliseconds timeout);
+    bool isClosed() const;
+    size_t availableSteps() const;
+    OperationStep stepAt(size_t index) const;
+
+    // 清空步骤。流式模式下步骤可能已被展示，此时忽略（open() 时已清空）
+    void clear();
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    bool streaming;
+    bool closed;
+    std::atomic<bool> cancelled;
+    size_t window;
+    size_t consumed; // 消费者已请求到的步骤数
+};
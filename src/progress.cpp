@@ -0,0 +1,33 @@
+#include "progress.h"
+
+std::atomic<const char*> Progress::stage{nullptr};
+std::atomic<size_t> Progress::done{0};
+std::atomic<size_t> Progress::total{0};
+
+void Progress::report(const char* s, size_t d, size_t t) {
+    done.store(d, std::memory_order_relaxed);
+    total.store(t, std::memory_order_relaxed);
+    stage.store(s, std::memory_order_relaxed);
+}
+
+void Progress::advance(const char* s) {
+    if (stage.load(std::memory_order_relaxed) != s) {
+        // 进入新的阶段，从头计数
+        done.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        stage.store(s, std::memory_order_relaxed);
+    }
+    done.fetch_add(1, std::memory_order_relaxed);
+}
+
+Progress::Snapshot Progress::current() {
+    return Snapshot{stage.load(std::memory_order_relaxed),
+                    done.load(std::memory_order_relaxed),
+                    total.load(std::memory_order_relaxed)};
+}
+
+void Progress::reset() {
+    stage.store(nullptr, std::memory_order_relaxed);
+    done.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+}
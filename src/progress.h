@@ -0,0 +1,31 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// 计算进度：耗时的内核在与取消检查点相同的粗粒度位置（每个主元、每个素数、每个子式）报告进度，
+// 界面线程定时读取并显示在状态栏。报告只是几次无锁的原子写入，没有界面读取时开销可以忽略。
+// 各字段分别读写，读到的快照可能来自相邻的两次报告，只用于显示
+class Progress {
+public:
+    struct Snapshot {
+        const char* stage;  // 当前阶段的说明，为空表示尚无内核报告进度
+        size_t done;
+        size_t total;       // 0 表示总量未知
+    };
+
+    // 报告 stage 阶段已完成 done 项、共 total 项；stage 必须是字符串字面量
+    static void report(const char* stage, size_t done, size_t total);
+
+    // stage 阶段又完成一项，总量未知（可在多个线程中同时调用，如并行的余子式展开）
+    static void advance(const char* stage);
+
+    static Snapshot current();
+
+    // 开始新的计算前清除上一次的进度
+    static void reset();
+
+private:
+    static std::atomic<const char*> stage;
+    static std::atomic<size_t> done;
+    static std::atomic<size_t> total;
+};
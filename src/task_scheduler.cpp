@@ -0,0 +1,270 @@
+#include "task_scheduler.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+const char* const TaskScheduler::THREADS_ENV = "LINALG_THREADS";
+
+namespace {
+
+struct Task {
+    std::function<void()> fn;
+    TaskGroup* group;
+};
+
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+// 未指定线程数时：先看环境变量，再看硬件线程数
+int defaultThreadCount() {
+    if (const char* env = std::getenv(TaskScheduler::THREADS_ENV)) {
+        try {
+            int n = std::stoi(env);
+            if (n > 0) {
+                return n;
+            }
+        } catch (const std::exception&) {
+            // 无效值按未设置处理
+        }
+    }
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// 第 0 号队列接收非工作线程（主线程、界面线程）提交的任务，第 i 号工作线程使用第 i 号队列
+thread_local size_t currentQueue = 0;
+
+class Pool {
+public:
+    explicit Pool(int threads) : queues(static_cast<size_t>(threads)) {
+        for (auto& q : queues) {
+            q = std::make_unique<WorkQueue>();
+        }
+        // 调用线程也参与计算，因此只需再启动 threads - 1 个工作线程
+        for (size_t i = 1; i < queues.size(); ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~Pool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (auto& t : workers) {
+            t.join();
+        }
+    }
+
+    int threads() const { return static_cast<int>(queues.size()); }
+
+    void push(Task task) {
+        WorkQueue& q = *queues[currentQueue < queues.size() ? currentQueue : 0];
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        queued.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wakeup.notify_one();
+    }
+
+    // 先取自己队列尾部的任务，没有则从其他队列头部窃取；执行了一个任务时返回 true
+    bool runOne() {
+        size_t self = currentQueue < queues.size() ? currentQueue : 0;
+        Task task;
+        if (!popBack(*queues[self], task)) {
+            bool stolen = false;
+            for (size_t k = 1; k < queues.size() && !stolen; ++k) {
+                stolen = popFront(*queues[(self + k) % queues.size()], task);
+            }
+            if (!stolen) {
+                return false;
+            }
+        }
+        queued.fetch_sub(1);
+
+        std::exception_ptr failure;
+        try {
+            task.fn();
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        task.group->finish(failure);
+        return true;
+    }
+
+private:
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+    bool stopping = false;
+
+    static bool popBack(WorkQueue& q, Task& out) {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) {
+            return false;
+        }
+        out = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    static bool popFront(WorkQueue& q, Task& out) {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) {
+            return false;
+        }
+        out = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        return true;
+    }
+
+    void workerLoop(size_t index) {
+        currentQueue = index;
+        while (true) {
+            if (runOne()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeup.wait(lock, [this] { return stopping || queued.load() > 0; });
+            if (stopping) {
+                return;
+            }
+        }
+    }
+};
+
+std::mutex poolMutex;
+std::atomic<Pool*> pool{nullptr}; // 故意不在退出时析构：进程结束时可能仍有计算在后台线程上运行
+int requestedThreads = 0;
+
+Pool& instance() {
+    Pool* current = pool.load(std::memory_order_acquire);
+    if (current) {
+        return *current;
+    }
+    std::lock_guard<std::mutex> lock(poolMutex);
+    current = pool.load(std::memory_order_relaxed);
+    if (!current) {
+        current = new Pool(requestedThreads > 0 ? requestedThreads : defaultThreadCount());
+        pool.store(current, std::memory_order_release);
+    }
+    return *current;
+}
+
+} // namespace
+
+void TaskScheduler::setThreadCount(int n) {
+    if (n < 0) {
+        throw std::invalid_argument("线程数不能为负数");
+    }
+    std::lock_guard<std::mutex> lock(poolMutex);
+    requestedThreads = n;
+    int target = n > 0 ? n : defaultThreadCount();
+    Pool* current = pool.load(std::memory_order_relaxed);
+    if (current && current->threads() != target) {
+        pool.store(nullptr, std::memory_order_release);
+        delete current;
+    }
+}
+
+int TaskScheduler::threadCount() {
+    return instance().threads();
+}
+
+void TaskScheduler::parallelFor(size_t begin, size_t end, const std::function<void(size_t)>& body) {
+    if (begin >= end) {
+        return;
+    }
+    size_t count = end - begin;
+    int threads = threadCount();
+    if (threads == 1 || count == 1) {
+        for (size_t i = begin; i < end; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    // 每个线程大约分到 4 块，兼顾负载均衡与调度开销
+    size_t chunks = std::min(count, static_cast<size_t>(threads) * 4);
+    TaskGroup group;
+    for (size_t c = 0; c < chunks; ++c) {
+        size_t first = begin + count * c / chunks;
+        size_t last = begin + count * (c + 1) / chunks;
+        group.run([first, last, &body] {
+            for (size_t i = first; i < last; ++i) {
+                body(i);
+            }
+        });
+    }
+    group.wait();
+}
+
+TaskGroup::~TaskGroup() {
+    waitAll();
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    Pool& p = instance();
+    if (p.threads() == 1) {
+        // 单线程时直接执行，异常留到 wait 时抛出，与多线程时的行为一致
+        pending.fetch_add(1);
+        std::exception_ptr failure;
+        try {
+            task();
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        finish(failure);
+        return;
+    }
+    pending.fetch_add(1);
+    p.push(Task{std::move(task), this});
+}
+
+void TaskGroup::finish(std::exception_ptr failure) {
+    if (failure) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) {
+            error = failure;
+        }
+    }
+    pending.fetch_sub(1);
+}
+
+void TaskGroup::waitAll() {
+    if (pending.load() == 0) {
+        return;
+    }
+    Pool& p = instance();
+    while (pending.load() > 0) {
+        if (!p.runOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskGroup::wait() {
+    waitAll();
+    std::exception_ptr failure;
+    {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        std::swap(failure, error);
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+// 全项目共用的工作窃取线程池。
+// 每个工作线程有自己的双端队列：自己从尾部取任务（后进先出，利于缓存），空闲时从其他队列头部窃取。
+// 等待任务组的线程不会阻塞，而是一边等一边执行队列里的任务，因此嵌套的 fork/join
+// （如余子式展开的各层子树）只会复用这固定数量的线程，不会超额订阅。
+// 线程数为 1 时所有任务都在调用线程上直接执行，与串行代码完全相同。
+class TaskScheduler {
+public:
+    // 设置参与计算的线程总数（含调用线程）。0 表示取环境变量 LINALG_THREADS，
+    // 未设置时取硬件线程数。只应在没有计算进行时调用
+    static void setThreadCount(int n);
+    static int threadCount();
+
+    // 对 [begin, end) 中的每个下标调用 body，各下标分块后并行执行；
+    // 返回时全部完成，任一调用抛出的第一个异常会在这里重新抛出
+    static void parallelFor(size_t begin, size_t end, const std::function<void(size_t)>& body);
+
+    // 环境变量名
+    static const char* const THREADS_ENV;
+};
+
+// fork/join 任务组：run 提交子任务，wait 等待全部完成。
+// 析构时会等待尚未完成的任务（此时不再抛出异常）
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    ~TaskGroup();
+
+    void run(std::function<void()> task);
+
+    // 等待期间当前线程会帮忙执行队列中的任务；子任务抛出的第一个异常在这里重新抛出
+    void wait();
+
+    // 线程池在一个子任务执行完毕后调用，failure 为该任务抛出的异常（没有则为空）
+    void finish(std::exception_ptr failure);
+
+private:
+    void waitAll();
+
+    std::atomic<size_t> pending{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
@@ -72,6 +72,25 @@ void EnhancedHelpViewer::initializeHelpContent() {
              "\033[1;33m> steps\033[0m\n"
              "\033[36m[效果: 计算步骤显示已开启]\033[0m"
             },
+            {"\033[1;36melim\033[22m", 
+             "查看或切换消元引擎。\n\n"
+             "步骤显示关闭时，行列式、秩、最简阶梯形和逆矩阵默认使用 Bareiss 无分数消元，"
+             "中间结果保持为整数；gauss 模式使用逐步约分的有理数高斯消元。\n"
+             "\033[1m用法:\033[0m elim [bareiss | gauss]\n"
+             "\n\033[2m示例:\033[0m\n"
+             "\033[1;33m> elim gauss\033[0m\n"
+             "\033[36m[效果: 当前消元引擎: 高斯消元]\033[0m"
+            },
+            {"\033[1;36mthreads\033[22m", 
+             "查看或设置计算线程池的线程数。\n\n"
+             "矩阵乘法、步骤显示关闭时的消元、多模行列式、按行列展开、特征多项式展开和多列求解"
+             "共用同一个工作窃取线程池，嵌套的并行任务不会超额占用线程，结果与单线程完全相同。"
+             "auto 表示使用环境变量 LINALG_THREADS 指定的线程数，未设置时使用 CPU 的硬件线程数。\n"
+             "\033[1m用法:\033[0m threads [线程数 | auto]\n"
+             "\n\033[2m示例:\033[0m\n"
+             "\033[1;33m> threads 4\033[0m\n"
+             "\033[36m[效果: 当前计算线程数: 4]\033[0m"
+            },
             {"\033[1;36mshow\033[22m", 
              "显示变量内容，支持格式化输出。\n\n"
              "\033[1m用法:\033[0m\n"
@@ -248,10 +267,12 @@ void EnhancedHelpViewer::initializeHelpContent() {
             // 拆分 det
             {"\033[1;36mdet()\033[22m", 
              "计算方阵的行列式（高斯消元法）。\n\n"
-             "\033[1m用法:\033[0m det(matrix)\n"
+             "\033[1m用法:\033[0m det(matrix) 或 det(matrix, \"方法\")\n"
              "\033[1m说明:\033[0m 适用于任意阶方阵，内部采用高斯消元法，速度快，支持分数精度。\n"
+             "方法可选 \"modular\"（多模/中国剩余定理，适合大矩阵）、\"gauss\"、\"expansion\"。\n"
              "\n\033[2m示例:\033[0m\n"
-             "\033[1;33m> d = det(m1)\033[0m\n"
+             "\033[1;33m> d = det(m1)\n"
+             "> d2 = det(m1, \"modular\")\033[0m\n"
              "\033[36m[效果: 结果为分数型行列式值]\033[0m"
             },
             // 新增 det_expansion
@@ -422,8 +443,8 @@ void EnhancedHelpViewer::initializeHelpContent() {
              "\n\033[1m说明:\033[0m\n"
              "- 支持求解一次和二次方程。对于二次方程，当解为无理数时，会以根式形式表示。\n"
              "- 根式中sqrt()表示平方根，cbrt()表示立方根，root(base,exp)表示base开exp次方根\n"
-             "- 对于高次方程，会尝试通过有理根定理进行因数分解\n"
-             "- 对于无法求得有理解的高次方程的根，系统将返回CANT_SOLVE\n"
+             "- 对于高次方程，会先在有理数范围内完全因式分解，再对一次、二次因子求根\n"
+             "- 三次及以上的不可约因子的根和复数根，系统将返回CANT_SOLVE\n"
              "\n\033[2m示例:\033[0m\n"
              "\033[1;33m> alg_solve(2*x^6 - 21*x^5 + 43*x^4 + 48*x^3 - 126*x^2 - 27*x + 81)\033[0m\n"
              "\033[36m[结果: x₁ = -1, x₂ = 1, x₃ = 3, x₄ = 3/2, x₅ = 3 + 3*sqrt(2), x₆ = 3 - 3*sqrt(2)]\033[0m\n"
@@ -3,6 +3,8 @@
 #include <string>
 #include <deque>
 #include <memory>
+#include <future>
+#include <chrono>
 #include <sstream>
 #include <vector> // Required for KNOWN_FUNCTIONS/COMMANDS
 #include "../grammar/grammar_interpreter.h"
@@ -25,6 +27,9 @@ const int MAX_HISTORY = 50;
 const int RESULT_AREA_TITLE_ROW = 2; // "输出区域:" 标题所在的行 (0-indexed)
 const int RESULT_AREA_CONTENT_START_ROW = RESULT_AREA_TITLE_ROW + 1; // 实际内容开始的第一行
 const int MATRIX_EDITOR_CELL_WIDTH = 8; // 矩阵编辑器单元格宽度
+const size_t STEP_STREAM_LOOKAHEAD = 64; // 新增：流式步骤展示时后台计算最多领先的步数
+const int BACKGROUND_RESULT_WAIT_MS = 50; // 新增：命令在此时间内算完则直接显示结果，否则转入后台执行
+const int PROGRESS_REFRESH_MS = 100;      // 新增：后台执行时状态栏进度的刷新周期
 
 class TuiApp {
 private:
@@ -61,6 +66,19 @@ private:
     ExpansionHistory currentExpHistory;
     bool isExpansionHistory;
 
+    // 新增：流式步骤展示，计算在后台线程中进行
+    StepStream* liveStream = nullptr;          // 非空表示步骤仍来自正在进行的计算
+    std::shared_ptr<std::unique_ptr<AstNode>> liveAst; // 流式展示中的命令，放弃浏览时转交给 runningAst
+    std::future<Variable> pendingResult;       // 后台计算的结果
+    bool pendingShowsResult = false;           // 结束后是否需要打印 "= 结果"
+    std::string pendingResultText;             // 计算结束后待打印的结果或错误
+    Color pendingResultColor = Color::CYAN;
+
+    // 新增：不显示步骤时耗时的命令在后台执行，结果同样通过 pendingResult 收取
+    std::shared_ptr<std::unique_ptr<AstNode>> runningAst; // 非空表示有命令正在后台执行
+    std::chrono::steady_clock::time_point commandStart;
+    bool runningSkipsSteps = false; // 后台命令来自已放弃浏览的步骤流，结束后只显示结果
+
     // 新增：增强型矩阵编辑器实例
     std::unique_ptr<EnhancedMatrixEditor> matrixEditor;
     // 新增：增强型变量预览器实例  
@@ -95,7 +113,12 @@ private:
     // 步骤显示模式相关函数
     void enterStepDisplayMode(const OperationHistory& history);
     void enterStepDisplayMode(const ExpansionHistory& history);
+    void enterStepDisplayMode(StepStream& stream); // 新增：计算尚未结束时边算边看
+    void finishLiveStream(bool abandon);           // 新增：收取后台计算结果，abandon 时不再等待剩余步骤
     void exitStepDisplayMode();
+    void pollRunningCommand();                                           // 新增：等待后台命令一个刷新周期并处理取消按键
+    void showCommandResult(const AstNode& ast, const Variable& result, bool allowStepMode = true);  // 新增：显示执行结果并更新状态
+    void reportCommandError(std::exception_ptr error);                   // 新增：显示执行失败或取消的信息
     void displayCurrentStep();
     void drawStepProgressBar();
 
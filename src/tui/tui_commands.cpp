@@ -18,6 +18,9 @@
 #include "enhanced_matrix_editor.h"
 #include "enhanced_help_viewer.h"  // 新增：帮助查看器头文件
 #include "tui_suggestion_box.h"
+#include "../task_scheduler.h"
+#include "../cancellation.h"
+#include "../progress.h"
 #include "../utils/convert_utils.h"
 
 
@@ -139,6 +142,56 @@ void TuiApp::executeCommand(const std::string &input)
             return;
         }
 
+        // 新增：处理elim命令，切换无步骤计算时使用的消元引擎
+        if (commandStr == "elim") {
+            if (commandArgs.size() == 1) {
+                if (commandArgs[0] == "bareiss") {
+                    MatrixOperations::setEliminationMode(EliminationMode::BAREISS);
+                } else if (commandArgs[0] == "gauss") {
+                    MatrixOperations::setEliminationMode(EliminationMode::GAUSSIAN);
+                } else {
+                    throw std::invalid_argument("无效的 elim 命令参数。用法: elim [bareiss | gauss]");
+                }
+            } else if (!commandArgs.empty()) {
+                throw std::invalid_argument("无效的 elim 命令参数。用法: elim [bareiss | gauss]");
+            }
+            std::string modeName = MatrixOperations::getEliminationMode() == EliminationMode::BAREISS
+                                       ? "Bareiss 无分数消元" : "高斯消元";
+            printToResultView("当前消元引擎: " + modeName + " (仅在步骤显示关闭时生效)", Color::YELLOW);
+            statusMessage = "消元引擎: " + modeName;
+            return;
+        }
+
+        // 新增：处理threads命令，设置计算线程池的线程数
+        if (commandStr == "threads") {
+            if (commandArgs.size() == 1) {
+                if (commandArgs[0] == "auto") {
+                    TaskScheduler::setThreadCount(0);
+                } else {
+                    int n = 0;
+                    try {
+                        size_t pos = 0;
+                        n = std::stoi(commandArgs[0], &pos);
+                        if (pos != commandArgs[0].size()) {
+                            n = 0;
+                        }
+                    } catch (const std::exception&) {
+                        n = 0;
+                    }
+                    if (n <= 0) {
+                        throw std::invalid_argument("无效的 threads 命令参数。用法: threads [线程数 | auto]");
+                    }
+                    TaskScheduler::setThreadCount(n);
+                }
+            } else if (!commandArgs.empty()) {
+                throw std::invalid_argument("无效的 threads 命令参数。用法: threads [线程数 | auto]");
+            }
+            std::string countText = std::to_string(TaskScheduler::threadCount());
+            printToResultView("当前计算线程数: " + countText, Color::YELLOW);
+            statusMessage = "计算线程数: " + countText;
+            return;
+        }
+
         // 新增：处理csv命令
         if (commandStr == "csv") {
             if (commandArgs.size() == 1) {
@@ -609,63 +662,144 @@ void TuiApp::executeCommand(const std::string &input)
         LOG_DEBUG("语法树创建成功，类型: " + std::to_string(static_cast<int>(ast->type)));
 
         // 从 Interpreter 执行 AST
-        Variable result = interpreter.execute(ast);
-        LOG_INFO("命令执行完成，结果类型: " + std::to_string(static_cast<int>(result.type)));
-        
-        bool enteredStepMode = false;
+        // 新增：计算期间 Ctrl-C 产生中断信号，用于取消计算而不是被当作普通按键。
+        // 中断信号打开的整个期间界面线程自己也持有一个 Scope（先于打开构造、晚于关闭析构）：
+        // 后台线程尚未建立或已经退出它的 Scope 时按下 Ctrl-C，信号处理函数仍只请求取消，不会退出程序
+        struct InterruptKeyGuard {
+            Cancellation::Scope cancellable;
+            InterruptKeyGuard() { Terminal::setInterruptSignal(true); }
+            ~InterruptKeyGuard() { Terminal::setInterruptSignal(false); }
+        } interruptKeys;
+        Variable result;
         if (interpreter.isShowingSteps()) {
-            const auto& opHistory = interpreter.getCurrentOpHistory();
-            if (opHistory.size() > 0) {
-                LOG_INFO("进入步骤展示模式 (OperationHistory), 步骤数: " + std::to_string(opHistory.size()));
-                // 命令已打印。如果是非命令节点，打印其最终结果。
-                if (ast->type != AstNodeType::COMMAND) { 
-                    printToResultView("= " + variableToString(result), Color::CYAN);
-                }
-                enterStepDisplayMode(opHistory); // enterStepDisplayMode 会使用当前的 resultRow
-                enteredStepMode = true;
+            // 新增：显示步骤时在后台线程计算，第一步生成后即可开始浏览，不必等整个计算结束
+            StepStream& stream = interpreter.getStepStream();
+            stream.open(STEP_STREAM_LOOKAHEAD);
+            auto sharedAst = std::make_shared<std::unique_ptr<AstNode>>(std::move(ast));
+            Progress::reset();
+            commandStart = std::chrono::steady_clock::now();
+            pendingResult = std::async(std::launch::async, [this, sharedAst, &stream]() {
+                struct CloseGuard {
+                    StepStream& s;
+                    ~CloseGuard() { s.close(); }
+                } guard{stream};
+                Cancellation::Scope cancellable;
+                return interpreter.execute(*sharedAst);
+            });
+            stream.waitForStep(0);
+            if (!stream.isClosed()) {
+                LOG_INFO("计算仍在进行，进入流式步骤展示模式");
+                pendingShowsResult = (*sharedAst)->type != AstNodeType::COMMAND;
+                liveAst = sharedAst;
+                enterStepDisplayMode(stream);
+                return;
             }
-
-            if (!enteredStepMode) { 
-                const auto& expHistory = interpreter.getCurrentExpHistory();
-                if (expHistory.size() > 0) {
-                    LOG_INFO("进入步骤展示模式 (ExpansionHistory), 步骤数: " + std::to_string(expHistory.size()));
-                    if (ast->type != AstNodeType::COMMAND) {
-                       printToResultView("= " + variableToString(result), Color::CYAN);
-                    }
-                    enterStepDisplayMode(expHistory); // enterStepDisplayMode 会使用当前的 resultRow
-                    enteredStepMode = true;
-                }
+            ast = std::move(*sharedAst);
+            result = pendingResult.get();
+        } else {
+            // 新增：不显示步骤时同样在后台线程计算。很快完成的命令直接显示结果；
+            // 耗时的命令转入后台执行，由主循环刷新状态栏中的进度并响应取消
+            auto sharedAst = std::make_shared<std::unique_ptr<AstNode>>(std::move(ast));
+            Progress::reset();
+            commandStart = std::chrono::steady_clock::now();
+            pendingResult = std::async(std::launch::async, [this, sharedAst]() {
+                Cancellation::Scope cancellable;
+                return interpreter.execute(*sharedAst);
+            });
+            if (pendingResult.wait_for(std::chrono::milliseconds(BACKGROUND_RESULT_WAIT_MS)) != std::future_status::ready) {
+                LOG_INFO("计算耗时较长，转入后台执行");
+                runningAst = sharedAst;
+                return;
             }
+            ast = std::move(*sharedAst);
+            result = pendingResult.get();
         }
+        showCommandResult(*ast, result);
+    }
+    catch (...)
+    {
+        reportCommandError(std::current_exception());
+    }
+}
 
-        if (!enteredStepMode) {
-            // 如果没有进入步骤模式，正常显示结果
-            // 命令已在开头打印。现在只需打印结果。
-            if (ast->type != AstNodeType::COMMAND) { // 只为非命令显示结果
+// 新增：显示命令的执行结果（需要时进入步骤展示模式）并更新状态栏消息
+void TuiApp::showCommandResult(const AstNode& ast, const Variable& result, bool allowStepMode)
+{
+    LOG_INFO("命令执行完成，结果类型: " + std::to_string(static_cast<int>(result.type)));
+    
+    bool enteredStepMode = false;
+    if (allowStepMode && interpreter.isShowingSteps()) {
+        const auto& opHistory = interpreter.getCurrentOpHistory();
+        if (opHistory.size() > 0) {
+            LOG_INFO("进入步骤展示模式 (OperationHistory), 步骤数: " + std::to_string(opHistory.size()));
+            // 命令已打印。如果是非命令节点，打印其最终结果。
+            if (ast.type != AstNodeType::COMMAND) { 
                 printToResultView("= " + variableToString(result), Color::CYAN);
             }
+            enterStepDisplayMode(opHistory); // enterStepDisplayMode 会使用当前的 resultRow
+            enteredStepMode = true;
         }
-        
-        // 更新状态消息
-        if (!enteredStepMode) { // 只有在未进入步骤模式时才更新常规状态
-            if (ast->type == AstNodeType::COMMAND) {
-                const CommandNode* cmdNode = static_cast<const CommandNode*>(ast.get());
-                if (cmdNode->command == "steps") {
-                    if (interpreter.isShowingSteps()) {
-                        statusMessage = "计算步骤显示已开启";
-                    } else {
-                        statusMessage = "计算步骤显示已关闭";
-                    }
-                } else if (cmdNode->command == "clear") {
-                     statusMessage = "屏幕已清除"; 
+
+        if (!enteredStepMode) { 
+            const auto& expHistory = interpreter.getCurrentExpHistory();
+            if (expHistory.size() > 0) {
+                LOG_INFO("进入步骤展示模式 (ExpansionHistory), 步骤数: " + std::to_string(expHistory.size()));
+                if (ast.type != AstNodeType::COMMAND) {
+                   printToResultView("= " + variableToString(result), Color::CYAN);
+                }
+                enterStepDisplayMode(expHistory); // enterStepDisplayMode 会使用当前的 resultRow
+                enteredStepMode = true;
+            }
+        }
+    }
+
+    if (!enteredStepMode) {
+        // 如果没有进入步骤模式，正常显示结果
+        // 命令已在开头打印。现在只需打印结果。
+        if (ast.type != AstNodeType::COMMAND) { // 只为非命令显示结果
+            printToResultView("= " + variableToString(result), Color::CYAN);
+        }
+    }
+    
+    // 更新状态消息
+    if (!enteredStepMode) { // 只有在未进入步骤模式时才更新常规状态
+        if (ast.type == AstNodeType::COMMAND) {
+            const CommandNode* cmdNode = static_cast<const CommandNode*>(&ast);
+            if (cmdNode->command == "steps") {
+                if (interpreter.isShowingSteps()) {
+                    statusMessage = "计算步骤显示已开启";
                 } else {
-                     statusMessage = "命令执行成功";
+                    statusMessage = "计算步骤显示已关闭";
                 }
+            } else if (cmdNode->command == "clear") {
+                 statusMessage = "屏幕已清除"; 
             } else {
-                statusMessage = "命令执行成功";
+                 statusMessage = "命令执行成功";
             }
+        } else {
+            statusMessage = "命令执行成功";
         }
     }
+}
+
+// 新增：显示命令执行失败或被取消的信息，同步执行与后台执行共用
+void TuiApp::reportCommandError(std::exception_ptr error)
+{
+    try
+    {
+        std::rethrow_exception(error);
+    }
+    catch (const OperationCancelled &e)
+    {
+        // 新增：计算被 Ctrl-C 取消，变量等会话状态保持不变
+        LOG_INFO("命令已取消");
+        Terminal::setCursor(resultRow, 0);
+        Terminal::setForeground(Color::YELLOW);
+        std::cout << e.what() << " (cancelled)" << std::endl;
+        Terminal::resetColor();
+
+        statusMessage = "计算已取消";
+    }
     catch (const std::out_of_range &e)
     {
         // 特别处理字符串越界错误
@@ -716,6 +850,36 @@ void TuiApp::executeCommand(const std::string &input)
     }
 }
 
+// 新增：命令在后台计算时由主循环反复调用。最多等待一个刷新周期，
+// 期间 Ctrl-C 或 ESC 请求取消，其余按键忽略；计算结束后显示结果或错误
+void TuiApp::pollRunningCommand()
+{
+    if (Terminal::hasInput()) {
+        int key = Terminal::readChar();
+        if (key == 3 || key == KEY_ESCAPE) {
+            LOG_INFO("请求取消后台计算");
+            Cancellation::request();
+        }
+    }
+
+    if (pendingResult.wait_for(std::chrono::milliseconds(PROGRESS_REFRESH_MS)) != std::future_status::ready) {
+        return;
+    }
+    std::shared_ptr<std::unique_ptr<AstNode>> ast = std::move(runningAst);
+    runningAst.reset();
+    bool allowStepMode = !runningSkipsSteps;
+    runningSkipsSteps = false;
+    try
+    {
+        Variable result = pendingResult.get();
+        showCommandResult(**ast, result, allowStepMode);
+    }
+    catch (...)
+    {
+        reportCommandError(std::current_exception());
+    }
+}
+
 // 说明:这是变量预览器编写前用于展示变量的函数
 //      现在已经弃用大部分内容,只用作-l参数时显示变量列表
 void TuiApp::showVariables(bool listOnly)
@@ -5,6 +5,10 @@
 #include <string>
 #include <algorithm> // For std::string::resize in drawStatusBar
 #include <memory>    // For std::make_unique in updateUI
+#include <sstream>
+#include <iomanip>   // For std::setprecision in drawStatusBar
+#include "../cancellation.h"
+#include "../progress.h"
 
 void TuiApp::drawHeader()
 {
@@ -52,6 +56,22 @@ void TuiApp::drawStatusBar()
 
     // 状态栏信息
     std::string status = " " + statusMessage;
+    if (runningAst) {
+        // 新增：后台计算时显示已用时间和内核报告的进度
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - commandStart).count();
+        std::ostringstream text;
+        text << " " << (Cancellation::requested() ? "正在取消" : "计算中") << " "
+             << std::fixed << std::setprecision(1) << elapsed << "s";
+        Progress::Snapshot progress = Progress::current();
+        if (progress.stage) {
+            text << " | " << progress.stage << " " << progress.done;
+            if (progress.total > 0) {
+                text << "/" << progress.total;
+            }
+        }
+        text << " | Ctrl-C/ESC 取消";
+        status = text.str();
+    }
 
     // 使用UTF-8视觉宽度计算来正确处理中文字符
     size_t statusVisualWidth = TuiUtils::calculateUtf8VisualWidth(status);
@@ -173,7 +193,12 @@ void TuiApp::run()
         std::cout.flush();
 
         // 处理输入
-        handleInput();
+        // 新增：命令在后台计算时不阻塞读键，按刷新周期重绘状态栏中的进度
+        if (runningAst) {
+            pollRunningCommand();
+        } else {
+            handleInput();
+        }
     }
 
     // 清理工作
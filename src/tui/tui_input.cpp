@@ -7,6 +7,7 @@
 #include "../utils/logger.h" // For LOG_DEBUG in handleInput
 #include "enhanced_matrix_editor.h" 
 #include "tui_suggestion_box.h" 
+#include "../cancellation.h"
 
 void TuiApp::handleInput()
 {
@@ -112,6 +113,13 @@ void TuiApp::handleInput()
         }
     } else if (inStepDisplayMode)
     {
+        if (key == 3 && liveStream)
+        {
+            // 新增：Ctrl-C 取消仍在后台进行的计算并退出步骤导航
+            Cancellation::request();
+            exitStepDisplayMode();
+            return;
+        }
         if (key == KEY_ESCAPE)
         {
             // ESC键退出步骤导航模式
@@ -132,7 +140,48 @@ void TuiApp::handleInput()
         else if (key == KEY_RIGHT || (key == 27 && Terminal::hasInput() && Terminal::readChar() == '[' && Terminal::readChar() == 'C'))
         {
             // 右箭头，显示下一步
-            if (currentStep < totalSteps - 1)
+            if (liveStream)
+            {
+                // 新增：流式模式下按需拉取下一步，必要时等待后台计算生成。
+                // 按刷新周期分段等待，期间 Ctrl-C 取消计算、ESC 放弃浏览，界面不会卡住
+                bool available = false;
+                while (!(available = liveStream->waitForStep(currentStep + 1, std::chrono::milliseconds(PROGRESS_REFRESH_MS))) &&
+                       !liveStream->isClosed())
+                {
+                    if (!Terminal::hasInput())
+                    {
+                        continue;
+                    }
+                    int pending = Terminal::readChar();
+                    if (pending == 3)
+                    {
+                        Cancellation::request();
+                        exitStepDisplayMode();
+                        return;
+                    }
+                    if (pending == KEY_ESCAPE && !Terminal::hasInput())
+                    {
+                        exitStepDisplayMode();
+                        return;
+                    }
+                }
+                if (available)
+                {
+                    currentStep++;
+                }
+                if (liveStream->isClosed())
+                {
+                    finishLiveStream(false);
+                }
+                else
+                {
+                    totalSteps = liveStream->availableSteps();
+                }
+                displayCurrentStep();
+                drawStepProgressBar();
+                drawStatusBar();
+            }
+            else if (currentStep < totalSteps - 1)
             {
                 currentStep++;
                 displayCurrentStep();
@@ -4,6 +4,7 @@
 #include <string>
 #include <sstream> // For std::stringstream in displayCurrentStep
 #include "../utils/logger.h" // For LOG_WARNING
+#include "../cancellation.h"
 
 // 进入步骤展示模式 - 操作历史版本
 void TuiApp::enterStepDisplayMode(const OperationHistory& history_param) { // Renamed parameter
@@ -57,8 +58,73 @@ void TuiApp::enterStepDisplayMode(const ExpansionHistory& history_param) { // Re
     drawStatusBar();
 }
 
+// 新增：进入步骤展示模式 - 流式版本，计算仍在后台进行
+void TuiApp::enterStepDisplayMode(StepStream& stream) {
+    if (matrixEditor) {
+        LOG_WARNING("Attempted to enter step display mode while editor is active. Exiting editor first.");
+        matrixEditor.reset();
+        initUI();
+    }
+
+    inStepDisplayMode = true;
+    currentStep = 0;
+    liveStream = &stream;
+    totalSteps = stream.availableSteps();
+    isExpansionHistory = false;
+    pendingResultText.clear();
+
+    this->stepDisplayStartRow = this->resultRow;
+
+    displayCurrentStep();
+    drawStepProgressBar();
+
+    statusMessage = "步骤导航模式(计算进行中): 使用←→箭头浏览步骤, ESC退出并跳过剩余步骤";
+    drawStatusBar();
+}
+
+// 新增：收取后台计算的结果。abandon 为 true 时取消步骤流，剩余计算不再记录步骤也不再等待浏览
+void TuiApp::finishLiveStream(bool abandon) {
+    if (!liveStream) return;
+    if (abandon) {
+        liveStream->cancel();
+        if (pendingResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            // 剩余计算转入后台执行，不在界面线程上等待：由主循环刷新进度并响应 Ctrl-C/ESC
+            LOG_INFO("放弃浏览剩余步骤，计算转入后台执行");
+            runningAst = std::move(liveAst);
+            runningSkipsSteps = true;
+            liveStream = nullptr;
+            return;
+        }
+    }
+
+    try {
+        Variable result = pendingResult.get();
+        pendingResultText = pendingShowsResult ? "= " + variableToString(result) : "";
+        pendingResultColor = Color::CYAN;
+        statusMessage = "计算完成";
+    } catch (const OperationCancelled& e) {
+        pendingResultText = std::string(e.what()) + " (cancelled)";
+        pendingResultColor = Color::YELLOW;
+        statusMessage = "计算已取消";
+    } catch (const std::exception& e) {
+        LOG_ERROR("命令执行失败: " + std::string(e.what()));
+        pendingResultText = "错误: " + std::string(e.what());
+        pendingResultColor = Color::RED;
+        statusMessage = "命令执行失败: 请查看日志文件";
+    }
+
+    if (!abandon) {
+        // 计算已结束，之后的浏览直接使用完整的历史
+        currentHistory = *liveStream;
+        totalSteps = currentHistory.size();
+    }
+    liveStream = nullptr;
+    liveAst.reset();
+}
+
 // 退出步骤展示模式
 void TuiApp::exitStepDisplayMode() {
+    finishLiveStream(true);
     inStepDisplayMode = false;
     
     // 清除结果区域
@@ -66,6 +132,17 @@ void TuiApp::exitStepDisplayMode() {
     
     // 更新状态消息
     statusMessage = "已退出步骤导航模式";
+
+    // 新增：流式计算的结果在退出后显示
+    if (!pendingResultText.empty()) {
+        printToResultView(pendingResultText, pendingResultColor);
+        if (pendingResultColor == Color::RED) {
+            statusMessage = "命令执行失败: 请查看日志文件";
+        } else if (pendingResultColor == Color::YELLOW) {
+            statusMessage = "计算已取消";
+        }
+        pendingResultText.clear();
+    }
     drawStatusBar();
 }
 
@@ -93,7 +170,7 @@ void TuiApp::displayCurrentStep() {
     if (stepDisplayStartRow >=0) {
         Terminal::setCursor(stepDisplayStartRow, 0);
         Terminal::setForeground(Color::YELLOW);
-        std::cout << "步骤 " << (currentStep + 1) << " / " << totalSteps << ":" << std::endl;
+        std::cout << "步骤 " << (currentStep + 1) << " / " << totalSteps << (liveStream ? "+ (计算中)" : "") << ":" << std::endl;
         Terminal::resetColor();
     }
         
@@ -107,7 +184,7 @@ void TuiApp::displayCurrentStep() {
         if (isExpansionHistory) {
             currentExpHistory.getStep(currentStep).print(step_ss);
         } else {
-            currentHistory.getStep(currentStep).print(step_ss);
+            (liveStream ? liveStream->stepAt(currentStep) : currentHistory.getStep(currentStep)).print(step_ss);
         }
         
         std::string step_line;
@@ -174,6 +174,25 @@ void Terminal::setRawMode(bool enable) {
 #endif
 }
 
+// 原始模式关闭了 ISIG，Ctrl-C 只是一个普通字符；计算期间界面线程不读输入，需要让它重新产生 SIGINT
+void Terminal::setInterruptSignal(bool enable) {
+#ifdef _WIN32
+    // Windows 控制台默认处理 Ctrl-C，由控制台事件处理函数接收
+    (void)enable;
+#else
+    struct termios current;
+    if (tcgetattr(STDIN_FILENO, &current) != 0) {
+        return;
+    }
+    if (enable) {
+        current.c_lflag |= ISIG;
+    } else {
+        current.c_lflag &= ~ISIG;
+    }
+    tcsetattr(STDIN_FILENO, TCSANOW, &current);
+#endif
+}
+
 // 读取一个字符
 int Terminal::readChar() {
 #ifdef _WIN32
@@ -90,6 +90,9 @@ public:
     
     // 启用/禁用原始模式（不需要回车确认输入）
     static void setRawMode(bool enable);
+
+    // 新增：原始模式下临时恢复 Ctrl-C 产生中断信号（计算期间用于取消计算）
+    static void setInterruptSignal(bool enable);
     
     // 读取一个字符（在原始模式下使用）
     static int readChar();
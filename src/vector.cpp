@@ -73,11 +73,11 @@ Fraction Vector::dot(const Vector& rhs) const {
         throw std::invalid_argument("Vector dot product error: dimensions mismatch.");
     }
     
-    Fraction result;
+    RationalAccumulator result;
     for (size_t i = 0; i < data.size(); ++i) {
-        result += data[i] * rhs.data[i];
+        result.fma(data[i], rhs.data[i]);
     }
-    return result;
+    return result.result();
 }
 
 // 向量叉乘实现（仅适用于三维向量）
@@ -96,10 +96,11 @@ Vector Vector::cross(const Vector& rhs) const {
 
 // 计算向量的模（长度/范数）
 Fraction Vector::norm() const {
-    Fraction sum_of_squares;
+    RationalAccumulator acc;
     for (const auto& value : data) {
-        sum_of_squares += value * value;
+        acc.fma(value, value);
     }
+    Fraction sum_of_squares = acc.result();
 
     // 检查分子和分母是否为完全平方数
     if (is_perfect_square(sum_of_squares.getNumerator()) && 
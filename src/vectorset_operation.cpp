@@ -15,67 +15,12 @@ static std::vector<std::string> genNames(const std::string& prefix, size_t n) {
     return names;
 }
 
-// 辅助：判断setA能否线性表示setB的所有列，返回系数矩阵和可表示性
-static std::pair<bool, Matrix> canRepresent(const Matrix& setA, const Matrix& setB) {
-    size_t n = setB.colCount();
-    size_t m = setA.colCount();
-    Matrix coeffs(m, n); // 每列为setB的一个向量的系数
-    bool allUnique = true;
-    // 原有解法
-    for (size_t j = 0; j < n; ++j) {
-        Matrix b_col(setB.rowCount(), 1);
-        for (size_t i = 0; i < setB.rowCount(); ++i)
-            b_col.at(i, 0) = setB.at(i, j);
-        EquationSolver solver;
-        EquationSolution sol = solver.solve(setA, b_col);
-        if (!sol.hasSolution()) return {false, Matrix(0,0)};
-        // 只支持唯一解
-        if (!sol.hasUniqueSolution()) return {false, Matrix(0,0)};
-        for (size_t k = 0; k < m; ++k)
-            coeffs.at(k, j) = sol.getParticularSolution().at(k, 0);
-    }
-    // 联合行最简化简法
-    Matrix setA_rref = setA;
-    Matrix setB_rref = setB;
-    // 做联合rref
-    setB_rref = unionrref(setA, setB);
-    setA_rref = setA;
-    unionrref(setA_rref, setB); // setA_rref 变成rref
-    // 检查setA_rref是否为单位阵
-    bool isIdentity = true;
-    size_t rows = setA_rref.rowCount(), cols = setA_rref.colCount();
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            if ((i == j && setA_rref.at(i, j) != Fraction(1)) || (i != j && setA_rref.at(i, j) != Fraction(0))) {
-                isIdentity = false;
-                break;
-            }
-        }
-        if (!isIdentity) break;
-    }
-    if (isIdentity && setB_rref.rowCount() == m) {
-        // setB_rref 的每一列就是线性表示系数
-        // 检查与原有解法是否一致
-        bool match = true;
-        for (size_t j = 0; j < n && match; ++j) {
-            for (size_t i = 0; i < m; ++i) {
-                if (coeffs.at(i, j) != setB_rref.at(i, j)) {
-                    match = false;
-                    break;
-                }
-            }
-        }
-        if (match) {
-            return {true, setB_rref}; // 优先返回联合rref结果
-        } else {
-            // 不一致，提示冲突
-            // 可以在外层输出提示
-            return {true, coeffs};
-        }
-    } else {
-        // 不能用联合rref法，保留原有解法
-        return {true, coeffs};
-    }
+// 辅助：判断setA能否线性表示setB的所有列（要求表示唯一），返回可表示性和系数矩阵（每列为setB的一个向量的系数）。
+// 对 [setA|setB] 只消元一次，rep 同时带回 rref(setA) 与同步变换后的 setB，供输出联合增广矩阵使用
+static std::pair<bool, Matrix> canRepresent(const Matrix& setA, const Matrix& setB, MultiEquationSolution& rep) {
+    rep = EquationSolver::solveMany(setA, setB);
+    if (!rep.hasUniqueSolutions()) return {false, Matrix(0, 0)};
+    return {true, rep.particularSolutions};
 }
 
 // 新增：对A做最简行阶梯形变换并同步对B做相同行变换，返回B的变换结果
@@ -99,8 +44,8 @@ Matrix unionrref(const Matrix& A, const Matrix& B) {
         }
         // 交换行
         if (i != r) {
-            for (size_t j = 0; j < colCount; ++j) std::swap(a.at(r, j), a.at(i, j));
-            for (size_t j = 0; j < b.colCount(); ++j) std::swap(b.at(r, j), b.at(i, j));
+            a.swapRows(r, i);
+            b.swapRows(r, i);
         }
         // 主元归一化
         Fraction pivot = a.at(r, lead);
@@ -112,8 +57,8 @@ Matrix unionrref(const Matrix& A, const Matrix& B) {
         for (size_t k = r + 1; k < rowCount; ++k) {
             Fraction factor = a.at(k, lead);
             if (factor != Fraction(0)) {
-                for (size_t j = 0; j < colCount; ++j) a.at(k, j) = a.at(k, j) - a.at(r, j) * factor;
-                for (size_t j = 0; j < b.colCount(); ++j) b.at(k, j) = b.at(k, j) - b.at(r, j) * factor;
+                for (size_t j = 0; j < colCount; ++j) a.at(k, j) = RationalAccumulator(a.at(k, j)).fms(a.at(r, j), factor).result();
+                for (size_t j = 0; j < b.colCount(); ++j) b.at(k, j) = RationalAccumulator(b.at(k, j)).fms(b.at(r, j), factor).result();
             }
         }
         ++lead;
@@ -128,8 +73,8 @@ Matrix unionrref(const Matrix& A, const Matrix& B) {
         for (int i = r - 1; i >= 0; --i) {
             Fraction factor = a.at(i, lead);
             if (factor != Fraction(0)) {
-                for (size_t j = 0; j < colCount; ++j) a.at(i, j) = a.at(i, j) - a.at(r, j) * factor;
-                for (size_t j = 0; j < b.colCount(); ++j) b.at(i, j) = b.at(i, j) - b.at(r, j) * factor;
+                for (size_t j = 0; j < colCount; ++j) a.at(i, j) = RationalAccumulator(a.at(i, j)).fms(a.at(r, j), factor).result();
+                for (size_t j = 0; j < b.colCount(); ++j) b.at(i, j) = RationalAccumulator(b.at(i, j)).fms(b.at(r, j), factor).result();
             }
         }
     }
@@ -148,15 +93,14 @@ Matrix rep_vecsingle(const Matrix& setA, const Vector& v) {
     // 求解 setA * x = v
     Matrix b_col(v.size(), 1);
     for (size_t i = 0; i < v.size(); ++i) b_col.at(i, 0) = v.at(i);
-    EquationSolver solver;
-    EquationSolution sol = solver.solve(setA, b_col);
-    if (!sol.hasSolution() || !sol.hasUniqueSolution()) {
+    MultiEquationSolution sol = EquationSolver::solveMany(setA, b_col);
+    if (!sol.hasUniqueSolutions()) {
         // 返回全0列
         Matrix zeroCol(setA.colCount(), 1);
         return zeroCol;
     } else {
         // 返回系数列
-        return sol.getParticularSolution();
+        return sol.particularSolutions;
     }
 }
 
@@ -238,10 +182,11 @@ Result rs_rep_vecset(const Matrix& set1, const Matrix& set2) {
     oss << "\n\n";
 
     // 5. set1能否表示set2
-    auto [can12, coeff12] = canRepresent(set1, set2);
-    // 新增：联合rref增广矩阵输出
-    Matrix set1_rref = MatrixOperations::toReducedRowEchelonForm(set1);
-    Matrix set2_rref = unionrref(set1, set2); // set2_rref已同步行变换
+    MultiEquationSolution rep12;
+    auto [can12, coeff12] = canRepresent(set1, set2, rep12);
+    // 新增：联合rref增广矩阵输出，直接取自同一次消元
+    Matrix set1_rref = rep12.reducedCoefficients;
+    Matrix set2_rref = rep12.reducedRightHandSides; // set2_rref已同步行变换
 
     oss << "\033[36m② set1 ────────> set2:\033[0m\n";
     if (can12) {
@@ -330,11 +275,11 @@ Result rs_rep_vecset(const Matrix& set1, const Matrix& set2) {
     }
 
     // 6. set2能否表示set1
-    auto [can21, coeff21] = canRepresent(set2, set1);
+    MultiEquationSolution rep21;
+    auto [can21, coeff21] = canRepresent(set2, set1, rep21);
     // 新增：联合rref增广矩阵输出
-    Matrix set1_rref2(0,0);
-    set2_rref = MatrixOperations::toReducedRowEchelonForm(set2);
-    set1_rref2 = unionrref(set2, set1);
+    Matrix set1_rref2 = rep21.reducedRightHandSides;
+    set2_rref = rep21.reducedCoefficients;
 
     oss << "\033[36m③ set2 ────────> set1:\033[0m\n";
     if (can21) {
@@ -2,7 +2,9 @@
 #include <vector>
 #include <windows.h>
 #include "../src/fraction.h"
+#include "../src/integer_factorization.h"
 #include "../src/matrix.h"
+#include "../src/task_scheduler.h"
 #include "../src/vector.h"
 
 // 用于测试的简单断言宏
@@ -44,6 +46,36 @@ bool testFraction()
     Fraction f8 = f6 * f7; // 10/3 * 15/2 = 150/6 = 25/1
     ASSERT(f8.getNumerator() == 25 && f8.getDenominator() == 1, "复合运算失败");
 
+    // 小整数溢出时应自动提升为大整数，结果回落后保持正确
+    Fraction big(4000000000000000000LL);
+    Fraction big2 = big * Fraction(10);
+    ASSERT(big2.getNumerator() == BigInt("40000000000000000000"), "溢出提升到大整数失败");
+    Fraction back = big2 / Fraction(20);
+    ASSERT(back.getNumerator() == BigInt("2000000000000000000") && back.getDenominator() == 1, "大整数降级失败");
+    ASSERT(big2 > big && Fraction(1, 3) < Fraction(1, 2), "比较运算失败");
+    ASSERT(Fraction(1, 3) + Fraction(1, 6) == Fraction(1, 2), "快速路径加法化简失败");
+
+    // 有理数累加器：1/2*1/3 + 1/4*2/3 - 1/6 = 1/6
+    RationalAccumulator acc;
+    acc.fma(Fraction(1, 2), Fraction(1, 3)).fma(Fraction(1, 4), Fraction(2, 3)).sub(Fraction(1, 6));
+    ASSERT(acc.result() == Fraction(1, 6), "有理数累加器计算错误");
+    acc.fma(big, big).fms(big, big);
+    ASSERT(acc.result() == Fraction(1, 6), "有理数累加器溢出提升失败");
+
+    // 整数分解服务：两个大于 2^32 的素因子需要 Pollard-rho 才能拆开
+    BigInt semiprime = BigInt("1000000000039") * BigInt("4294967311") * 360;
+    IntegerFactorization::Factors factors = IntegerFactorization::factor(semiprime);
+    ASSERT(factors.size() == 5 && factors[3].first == BigInt("4294967311") && factors[4].first == BigInt("1000000000039"),
+           "整数分解结果不正确");
+    ASSERT(IntegerFactorization::divisors(360).size() == 24, "因数枚举不完整");
+    ASSERT(IntegerFactorization::isProbablePrime(BigInt("1000000000000000000000000000057")) &&
+               !IntegerFactorization::isProbablePrime(BigInt("3825123056546413051")),
+           "素性测试错误");
+    BigInt power = boost::multiprecision::pow(BigInt("123456789012345"), 5);
+    ASSERT(is_perfect_nth_root(Fraction(power, 32), 5) && !is_perfect_nth_root(Fraction(power + 1), 5),
+           "完全方幂判断错误");
+    ASSERT(nth_root(Fraction(-power), 5) == Fraction(-BigInt("123456789012345")), "n次方根计算错误");
+
     // 输出测试
     std::cout << "f1: " << f1 << std::endl;
     std::cout << "f2: " << f2 << std::endl;
@@ -140,6 +172,26 @@ bool testMatrix()
     ASSERT(m9.at(1, 0).getNumerator() == 10 && m9.at(1, 0).getDenominator() == 1, "矩阵乘法结果不正确");
     ASSERT(m9.at(1, 1).getNumerator() == 12 && m9.at(1, 1).getDenominator() == 1, "矩阵乘法结果不正确");
 
+    // 较大矩阵的分块并行乘法应与单线程结果完全一致
+    Matrix big1(70, 45), big2(45, 66);
+    for (size_t i = 0; i < big1.rowCount(); ++i)
+        for (size_t j = 0; j < big1.colCount(); ++j)
+            big1.at(i, j) = Fraction(static_cast<long long>((i * 7 + j * 3) % 11) - 5, static_cast<long long>(j % 4 + 1));
+    for (size_t i = 0; i < big2.rowCount(); ++i)
+        for (size_t j = 0; j < big2.colCount(); ++j)
+            big2.at(i, j) = Fraction(static_cast<long long>((i * 5 + j) % 9) - 4, static_cast<long long>(i % 3 + 1));
+    TaskScheduler::setThreadCount(1);
+    Matrix serialProduct = big1 * big2;
+    TaskScheduler::setThreadCount(4);
+    Matrix parallelProduct = big1 * big2;
+    TaskScheduler::setThreadCount(0);
+    bool sameProduct = true;
+    for (size_t i = 0; i < serialProduct.rowCount(); ++i)
+        for (size_t j = 0; j < serialProduct.colCount(); ++j)
+            if (serialProduct.at(i, j) != parallelProduct.at(i, j)) sameProduct = false;
+    std::cout << "70x45 与 45x66 矩阵并行乘法结果" << (sameProduct ? "与单线程一致" : "与单线程不一致") << std::endl;
+    ASSERT(sameProduct, "并行矩阵乘法结果不正确");
+
     return true;
 }
 
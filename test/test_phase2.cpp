@@ -3,9 +3,13 @@
 #include <windows.h>
 #include "../src/fraction.h"
 #include "../src/matrix.h"
+#include "../src/task_scheduler.h"
 #include "../src/vector.h"
 #include "../src/matrix_operations.h"
 #include "../src/operation_step.h"
+#include "../src/cancellation.h"
+#include "../src/progress.h"
+#include "../src/modular_arithmetic.h"
 
 // 测试初等行变换
 void testRowOperations() {
@@ -83,6 +87,17 @@ void testReducedRowEchelonForm() {
     // 打印所有操作历史
     std::cout << "\n最简行阶梯形变换操作历史:" << std::endl;
     history.printAll();
+
+    // 行变换步骤只记录操作，最后一步的矩阵由检查点重放得到，应与变换结果一致
+    Matrix replayed = history.getStep(history.size() - 1).getMatrixState();
+    bool same = true;
+    for (size_t i = 0; i < m.rowCount(); ++i) {
+        for (size_t j = 0; j < m.colCount(); ++j) {
+            if (replayed.at(i, j) != m.at(i, j)) same = false;
+        }
+    }
+    std::cout << "共 " << history.size() << " 步，保存完整矩阵 " << history.storedMatrixCount()
+              << " 个，重放结果" << (same ? "一致" : "不一致") << std::endl;
 }
 
 // 测试矩阵秩的计算
@@ -147,6 +162,138 @@ void testDeterminant() {
     std::cout << "行列式值: " << det2 << std::endl;
 }
 
+// 测试并行消元：不记录步骤时，较大矩阵的消元结果应与单线程完全一致
+void testParallelElimination() {
+    std::cout << "\n=== 测试并行消元 ===\n" << std::endl;
+
+    Matrix m(48, 52);
+    for (size_t i = 0; i < m.rowCount(); ++i) {
+        for (size_t j = 0; j < m.colCount(); ++j) {
+            m.at(i, j) = Fraction(static_cast<long long>((i * 13 + j * 7) % 17) - 8, static_cast<long long>((i + j) % 3 + 1));
+        }
+    }
+
+    bool same = true;
+    for (EliminationMode mode : {EliminationMode::BAREISS, EliminationMode::GAUSSIAN}) {
+        MatrixOperations::setEliminationMode(mode);
+        TaskScheduler::setThreadCount(1);
+        Matrix serialRef = MatrixOperations::toRowEchelonForm(m);
+        Matrix serialRref = MatrixOperations::toReducedRowEchelonForm(m);
+        TaskScheduler::setThreadCount(4);
+        Matrix parallelRef = MatrixOperations::toRowEchelonForm(m);
+        Matrix parallelRref = MatrixOperations::toReducedRowEchelonForm(m);
+        for (size_t i = 0; i < m.rowCount(); ++i) {
+            for (size_t j = 0; j < m.colCount(); ++j) {
+                if (serialRef.at(i, j) != parallelRef.at(i, j) || serialRref.at(i, j) != parallelRref.at(i, j)) {
+                    same = false;
+                }
+            }
+        }
+    }
+    MatrixOperations::setEliminationMode(EliminationMode::BAREISS);
+    TaskScheduler::setThreadCount(0);
+    std::cout << "48x52 矩阵的并行消元结果" << (same ? "与单线程一致" : "与单线程不一致") << std::endl;
+}
+
+// 测试协作式取消：请求取消后消元在下一个主元步骤处中止，新的计算不受影响
+void testCancellation() {
+    std::cout << "\n=== 测试取消计算 ===\n" << std::endl;
+
+    Matrix m(3, 3);
+    m.at(0, 0) = Fraction(2); m.at(0, 1) = Fraction(1); m.at(0, 2) = Fraction(1);
+    m.at(1, 0) = Fraction(1); m.at(1, 1) = Fraction(3); m.at(1, 2) = Fraction(2);
+    m.at(2, 0) = Fraction(1); m.at(2, 1) = Fraction(0); m.at(2, 2) = Fraction(0);
+
+    {
+        Cancellation::Scope scope;
+        Cancellation::request();
+        try {
+            MatrixOperations::determinant(m);
+            std::cout << "取消请求未生效" << std::endl;
+        } catch (const OperationCancelled& e) {
+            std::cout << "行列式计算: " << e.what() << std::endl;
+        }
+    }
+    {
+        Cancellation::Scope scope;
+        std::cout << "重新计算行列式: " << MatrixOperations::determinant(m) << std::endl;
+    }
+}
+
+// 测试特征多项式：Berkowitz 算法给出 det(xI - A) 的系数，常数项为 (-1)^n det(A)，x^{n-1} 的系数为 -tr(A)
+void testCharacteristicPolynomial() {
+    std::cout << "\n=== 测试特征多项式 ===\n" << std::endl;
+
+    Matrix m(3, 3);
+    m.at(0, 0) = Fraction(2);    m.at(0, 1) = Fraction(1, 2); m.at(0, 2) = Fraction(0);
+    m.at(1, 0) = Fraction(1);    m.at(1, 1) = Fraction(3);    m.at(1, 2) = Fraction(-1);
+    m.at(2, 0) = Fraction(1, 3); m.at(2, 1) = Fraction(0);    m.at(2, 2) = Fraction(4);
+
+    std::cout << "矩阵:" << std::endl;
+    m.print();
+
+    std::vector<Fraction> coefficients = MatrixOperations::characteristicPolynomial(m);
+    std::cout << "det(xI - A) 的系数（从 x^3 到常数项）:";
+    for (size_t k = coefficients.size(); k-- > 0;) {
+        std::cout << " " << coefficients[k];
+    }
+    std::cout << std::endl;
+
+    Fraction trace = m.at(0, 0) + m.at(1, 1) + m.at(2, 2);
+    bool consistent = coefficients[2] == Fraction(0) - trace &&
+                      coefficients[0] == Fraction(0) - MatrixOperations::determinant(m);
+    std::cout << "与迹和行列式" << (consistent ? "一致" : "不一致") << std::endl;
+}
+
+// 测试进度报告：消元的每个主元步骤都会更新进度，供界面在状态栏显示
+void testProgress() {
+    std::cout << "\n=== 测试进度报告 ===\n" << std::endl;
+
+    Matrix m(4, 4);
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            m.at(i, j) = Fraction(static_cast<long long>(i == j ? 5 : i + j));
+        }
+    }
+
+    Progress::reset();
+    std::cout << "开始前: " << (Progress::current().stage ? "有进度" : "无进度") << std::endl;
+    MatrixOperations::determinant(m);
+    Progress::Snapshot progress = Progress::current();
+    std::cout << "行列式计算后: " << (progress.stage ? progress.stage : "无进度")
+              << " " << progress.done << "/" << progress.total << std::endl;
+}
+
+// 测试多模多项式乘法：数论变换求值/插值后用中国剩余定理重构，结果应与逐项卷积一致
+void testPolynomialProduct() {
+    std::cout << "\n=== 测试多模多项式乘法 ===\n" << std::endl;
+
+    // (2x - 3)(x^2 + 5) = 2x^3 - 3x^2 + 10x - 15，系数按升幂排列
+    std::vector<BigInt> small = ModularOperations::integerPolynomialProduct({BigInt(-3), BigInt(2)}, {BigInt(5), BigInt(0), BigInt(1)});
+    std::cout << "(2x - 3)(x^2 + 5) 的系数（从常数项到 x^3）:";
+    for (const auto& c : small) {
+        std::cout << " " << c;
+    }
+    std::cout << std::endl;
+
+    // 系数超过单个素数范围时需要多个素数
+    std::vector<BigInt> a(300), b(200);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = (BigInt(1) << 100) * static_cast<long long>(i % 7) - static_cast<long long>(i * i);
+    }
+    for (size_t j = 0; j < b.size(); ++j) {
+        b[j] = (BigInt(1) << 90) - static_cast<long long>(j * 31 % 17) * (BigInt(1) << 95);
+    }
+    std::vector<BigInt> expected(a.size() + b.size() - 1, BigInt(0));
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < b.size(); ++j) {
+            expected[i + j] += a[i] * b[j];
+        }
+    }
+    bool same = ModularOperations::integerPolynomialProduct(a, b) == expected;
+    std::cout << "300 项与 200 项多项式之积与逐项卷积" << (same ? "一致" : "不一致") << std::endl;
+}
+
 int main() {
     SetConsoleCP(65001);       // 设置控制台输入为UTF-8编码
     SetConsoleOutputCP(65001); // 设置控制台输出为UTF-8编码
@@ -158,6 +305,11 @@ int main() {
     testReducedRowEchelonForm();
     testMatrixRank();
     testDeterminant();
+    testParallelElimination();
+    testCancellation();
+    testCharacteristicPolynomial();
+    testProgress();
+    testPolynomialProduct();
     
     return 0;
 }
@@ -62,6 +62,70 @@ void testDeterminantByExpansion() {
     OperationHistory gaussHistory;
     Fraction detGauss = MatrixOperations::determinant(m, gaussHistory);
     std::cout << "\n使用高斯消元法计算的行列式值: " << detGauss << std::endl;
+
+    // 较大矩阵：子式缓存使按行列展开在合理时间内完成
+    const size_t n = 12;
+    Matrix big(n, n);
+    unsigned long long seed = 12345;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            seed = (seed * 1103515245ULL + 12345ULL) % 2147483648ULL;
+            big.at(i, j) = Fraction(static_cast<long long>(seed % 17) - 8, static_cast<long long>(j % 3) + 1);
+        }
+    }
+    Fraction bigDet = big.determinantByExpansion();
+    OperationHistory bigHistory;
+    Fraction bigDetGauss = MatrixOperations::determinant(big, bigHistory);
+    std::cout << "\n12x12 矩阵按行列展开: " << bigDet << ", 高斯消元: " << bigDetGauss
+              << ", 结果" << (bigDet == bigDetGauss ? "一致" : "不一致") << std::endl;
+
+    // 不记录步骤时走 Bareiss 无分数消元
+    Fraction bigDetBareiss = MatrixOperations::determinant(big);
+    std::cout << "12x12 矩阵 Bareiss 消元: " << bigDetBareiss
+              << ", 结果" << (bigDetBareiss == bigDetGauss ? "一致" : "不一致") << std::endl;
+
+    // 多模算法 + 中国剩余定理
+    Fraction bigDetModular = MatrixOperations::determinantModular(big);
+    std::cout << "12x12 矩阵多模算法: " << bigDetModular
+              << ", 结果" << (bigDetModular == bigDetGauss ? "一致" : "不一致") << std::endl;
+}
+
+bool sameEntries(const Matrix& a, const Matrix& b) {
+    if (a.rowCount() != b.rowCount() || a.colCount() != b.colCount()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.rowCount(); ++i) {
+        for (size_t j = 0; j < a.colCount(); ++j) {
+            if (a.at(i, j) != b.at(i, j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void testEchelonFormConsistency() {
+    std::cout << "\n=== 测试行阶梯形与步骤模式一致 ===\n" << std::endl;
+
+    Matrix a(3, 3);
+    a.at(0, 0) = Fraction(2); a.at(0, 1) = Fraction(4); a.at(0, 2) = Fraction(6);
+    a.at(1, 0) = Fraction(1); a.at(1, 1) = Fraction(3); a.at(1, 2) = Fraction(2);
+    a.at(2, 0) = Fraction(3); a.at(2, 1) = Fraction(1); a.at(2, 2) = Fraction(1, 2);
+
+    // 行阶梯形不唯一：不显示步骤时也必须给出与步骤模式相同的结果
+    Matrix stepped = a;
+    OperationHistory history;
+    MatrixOperations::toRowEchelonForm(stepped, history);
+    Matrix plain = MatrixOperations::toRowEchelonForm(a);
+    plain.print();
+    std::cout << "行阶梯形与步骤模式" << (sameEntries(plain, stepped) ? "一致" : "不一致") << std::endl;
+
+    // 最简行阶梯形唯一，Bareiss 与有理数消元结果相同
+    Matrix reducedStepped = a;
+    OperationHistory reducedHistory;
+    MatrixOperations::toReducedRowEchelonForm(reducedStepped, reducedHistory);
+    Matrix reduced = MatrixOperations::toReducedRowEchelonForm(a);
+    std::cout << "最简行阶梯形与步骤模式" << (sameEntries(reduced, reducedStepped) ? "一致" : "不一致") << std::endl;
 }
 
 int main() {
@@ -72,6 +136,7 @@ int main() {
     
     testCofactorAndAdjugate();
     testDeterminantByExpansion();
+    testEchelonFormConsistency();
     
     return 0;
 }
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include <stdexcept>
 #include <windows.h>
 #include "../src/fraction.h"
 #include "../src/matrix.h"
@@ -7,6 +8,8 @@
 #include "../src/matrix_operations.h"
 #include "../src/operation_step.h"
 #include "../src/equationset.h"
+#include "../src/factorization.h"
+#include "../src/task_scheduler.h"
 
 // 测试唯一解的线性方程组
 void testUniqueQEquation() {
@@ -211,6 +214,145 @@ void testEquationSystemAnalysis() {
     }
 }
 
+// 测试较大的唯一解方程组：不记录步骤时走 p-adic 提升求解，结果应与消元法一致
+void testLargeUniqueEquation() {
+    std::cout << "\n=== 测试较大的唯一解方程组 ===\n" << std::endl;
+
+    const size_t n = 15;
+    Matrix A(n, n);
+    Matrix b(n, 1);
+    unsigned long long seed = 2024;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            seed = (seed * 1103515245ULL + 12345ULL) % 2147483648ULL;
+            A.at(i, j) = Fraction(static_cast<long long>(seed % 41) - 20, static_cast<long long>(i % 4) + 1);
+        }
+        b.at(i, 0) = Fraction(static_cast<long long>(i) - 7);
+    }
+
+    EquationSolution fast = EquationSolver::solve(A, b);
+    OperationHistory history;
+    EquationSolution reference = EquationSolver::solve(A, b, history);
+
+    bool same = fast.hasUniqueSolution() && reference.hasUniqueSolution();
+    for (size_t i = 0; same && i < n; ++i) {
+        same = fast.getParticularSolution().at(i, 0) == reference.getParticularSolution().at(i, 0);
+    }
+    std::cout << "15x15 方程组 x1 = " << fast.getParticularSolution().at(0, 0)
+              << ", 与消元法结果" << (same ? "一致" : "不一致") << std::endl;
+}
+
+// 测试 PLU 分解复用：一次分解同时用于行列式、求解、求逆和零空间
+void testFactorizationReuse() {
+    std::cout << "\n=== 测试 PLU 分解复用 ===\n" << std::endl;
+
+    Matrix A(3, 4);
+    A.at(0, 0) = Fraction(1); A.at(0, 1) = Fraction(2); A.at(0, 2) = Fraction(-1); A.at(0, 3) = Fraction(3);
+    A.at(1, 0) = Fraction(2); A.at(1, 1) = Fraction(4); A.at(1, 2) = Fraction(1);  A.at(1, 3) = Fraction(0);
+    A.at(2, 0) = Fraction(3); A.at(2, 1) = Fraction(6); A.at(2, 2) = Fraction(0);  A.at(2, 3) = Fraction(3);
+    Matrix b(3, 1);
+    b.at(0, 0) = Fraction(2); b.at(1, 0) = Fraction(7); b.at(2, 0) = Fraction(9);
+
+    Factorization factors(A);
+    EquationSolution viaFactors = EquationSolver::solve(factors, b);
+    EquationSolution reference = EquationSolver::solve(A, b);
+    std::cout << "秩: " << factors.rank() << "，零空间维数: " << factors.nullspace().colCount()
+              << "，解的描述与消元法" << (viaFactors.getDetailedDescription() == reference.getDetailedDescription() ? "一致" : "不一致")
+              << std::endl;
+
+    Matrix B(3, 3);
+    B.at(0, 0) = Fraction(2); B.at(0, 1) = Fraction(1, 2); B.at(0, 2) = Fraction(1);
+    B.at(1, 0) = Fraction(0); B.at(1, 1) = Fraction(3);    B.at(1, 2) = Fraction(-1);
+    B.at(2, 0) = Fraction(4); B.at(2, 1) = Fraction(0);    B.at(2, 2) = Fraction(1, 3);
+    Factorization squareFactors(B);
+    Matrix product = squareFactors.inverse() * B;
+    bool identity = true;
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            if (product.at(i, j) != Fraction(i == j ? 1 : 0)) identity = false;
+        }
+    }
+    std::cout << "det = " << squareFactors.det() << "（消元法: " << MatrixOperations::determinant(B)
+              << "），逆矩阵校验" << (identity ? "通过" : "失败") << std::endl;
+}
+
+// 测试多右端项求解：[A|B] 只消元一次，逐列给出解
+void testSolveMany() {
+    std::cout << "\n=== 测试多右端项方程组求解 ===\n" << std::endl;
+
+    Matrix A(3, 2);
+    A.at(0, 0) = Fraction(1); A.at(0, 1) = Fraction(0);
+    A.at(1, 0) = Fraction(0); A.at(1, 1) = Fraction(1);
+    A.at(2, 0) = Fraction(1); A.at(2, 1) = Fraction(1);
+    Matrix B(3, 3);
+    B.at(0, 0) = Fraction(2); B.at(0, 1) = Fraction(1, 2); B.at(0, 2) = Fraction(1);
+    B.at(1, 0) = Fraction(3); B.at(1, 1) = Fraction(-1);   B.at(1, 2) = Fraction(1);
+    B.at(2, 0) = Fraction(5); B.at(2, 1) = Fraction(-1, 2); B.at(2, 2) = Fraction(0);
+
+    MultiEquationSolution result = EquationSolver::solveMany(A, B);
+    std::cout << "系数矩阵的秩: " << result.coefficientRank << std::endl;
+    for (size_t j = 0; j < B.colCount(); ++j) {
+        Matrix b(3, 1);
+        for (size_t i = 0; i < 3; ++i) b.at(i, 0) = B.at(i, j);
+        EquationSolution single = EquationSolver::solve(A, b);
+        bool same = single.hasSolution() == result.consistent[j];
+        if (same && single.hasSolution()) {
+            for (size_t i = 0; i < 2; ++i) {
+                if (single.getParticularSolution().at(i, 0) != result.particularSolutions.at(i, j)) same = false;
+            }
+        }
+        std::cout << "第 " << (j + 1) << " 列: " << (result.consistent[j] ? "有解" : "无解")
+                  << "，与逐列求解" << (same ? "一致" : "不一致") << std::endl;
+    }
+}
+
+// 测试线程池：多列求解与按行列展开在多线程下应与单线程结果一致，子任务的异常应传回调用方
+void testTaskScheduler() {
+    std::cout << "\n=== 测试工作窃取线程池 ===\n" << std::endl;
+
+    Matrix A(10, 10);
+    for (size_t i = 0; i < 10; ++i) {
+        for (size_t j = 0; j < 10; ++j) {
+            A.at(i, j) = Fraction(static_cast<long long>((i * 7 + j * j) % 13) - 6, static_cast<long long>(j % 3 + 1));
+        }
+    }
+    Matrix B(10, 12);
+    for (size_t i = 0; i < 10; ++i) {
+        for (size_t j = 0; j < 12; ++j) {
+            B.at(i, j) = Fraction(static_cast<long long>((i + 3 * j) % 7) - 3);
+        }
+    }
+
+    TaskScheduler::setThreadCount(1);
+    Fraction serialDet = A.determinantByExpansion();
+    std::vector<bool> serialConsistent;
+    Matrix serialX = Factorization(A).solveMany(B, serialConsistent);
+
+    TaskScheduler::setThreadCount(4);
+    Fraction parallelDet = A.determinantByExpansion();
+    std::vector<bool> parallelConsistent;
+    Matrix parallelX = Factorization(A).solveMany(B, parallelConsistent);
+
+    bool same = serialDet == parallelDet && serialConsistent == parallelConsistent;
+    for (size_t i = 0; i < serialX.rowCount(); ++i) {
+        for (size_t j = 0; j < serialX.colCount(); ++j) {
+            if (serialX.at(i, j) != parallelX.at(i, j)) same = false;
+        }
+    }
+    std::cout << "4 线程下展开行列式与多列求解" << (same ? "与单线程一致" : "与单线程不一致") << std::endl;
+
+    bool caught = false;
+    try {
+        TaskScheduler::parallelFor(0, 64, [](size_t i) {
+            if (i == 41) throw std::runtime_error("任务失败");
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    std::cout << "子任务异常" << (caught ? "已传回调用方" : "未传回调用方") << std::endl;
+    TaskScheduler::setThreadCount(0);
+}
+
 int main() {
     SetConsoleCP(65001);       // 设置控制台输入为UTF-8编码
     SetConsoleOutputCP(65001); // 设置控制台输出为UTF-8编码
@@ -222,6 +364,10 @@ int main() {
     testNoSolutionEquation();
     testHomogeneousEquation();
     testEquationSystemAnalysis();
+    testLargeUniqueEquation();
+    testFactorizationReuse();
+    testSolveMany();
+    testTaskScheduler();
     
     return 0;
 }
@@ -0,0 +1,190 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <windows.h>
+#include "../src/fraction.h"
+#include "../src/algebra/polynomial.h"
+#include "../src/algebra/dense_polynomial.h"
+#include "../src/algebra/polynomial_factoring.h"
+#include "../src/algebra/polynomial_matrix.h"
+
+using namespace Algebra;
+
+// 用于测试的简单断言宏
+#define ASSERT(condition, message)                                 \
+    if (!(condition))                                              \
+    {                                                              \
+        std::cerr << "Assertion failed: " << message << std::endl; \
+        return false;                                              \
+    }
+
+// 由升幂整数系数构造稠密多项式
+DensePolynomial dense(const std::vector<long long>& coeffs)
+{
+    std::vector<Fraction> result;
+    for (long long c : coeffs)
+    {
+        result.push_back(Fraction(c));
+    }
+    return DensePolynomial(result);
+}
+
+// 测试 Q 上的完全因式分解
+bool testPolynomialFactoring()
+{
+    std::cout << "\n=== 测试多项式因式分解 ===\n" << std::endl;
+    Fraction content;
+
+    // x^4 + 1 模每个素数都可约，但在 Z 上不可约
+    std::vector<PolynomialFactoring::Factor> factors = PolynomialFactoring::factor(dense({1, 0, 0, 0, 1}), content);
+    ASSERT(factors.size() == 1 && factors[0].polynomial.degree() == 4 && factors[0].multiplicity == 1 && content == Fraction(1),
+           "x^4+1 应不可约");
+
+    // sqrt(2)+sqrt(3)+sqrt(5) 的极小多项式：模 p 因子很多，需要组合试除才能确认不可约
+    factors = PolynomialFactoring::factor(dense({576, 0, -960, 0, 352, 0, -40, 0, 1}), content);
+    ASSERT(factors.size() == 1 && factors[0].polynomial.degree() == 8, "x^8-40x^6+352x^4-960x^2+576 应不可约");
+
+    // 3/2 * (x - 1)^2 * (x^2 + 2)^3 * (2x + 3)：重因子与非单位的容度
+    DensePolynomial product = (dense({-1, 1}).pow(2) * dense({2, 0, 1}).pow(3) * dense({3, 2})) * Fraction(3, 2);
+    factors = PolynomialFactoring::factor(product, content);
+    ASSERT(factors.size() == 3, "重因子分解的因子个数错误");
+    // 按次数递增，同次数按重数递增
+    ASSERT(factors[0].polynomial.coefficients() == dense({3, 2}).coefficients() && factors[0].multiplicity == 1,
+           "因子 (2x + 3) 错误");
+    ASSERT(factors[1].polynomial.coefficients() == dense({-1, 1}).coefficients() && factors[1].multiplicity == 2,
+           "因子 (x - 1)^2 错误");
+    ASSERT(factors[2].polynomial.coefficients() == dense({2, 0, 1}).coefficients() && factors[2].multiplicity == 3,
+           "因子 (x^2 + 2)^3 错误");
+    ASSERT(content == Fraction(3, 2), "容度错误");
+
+    // 无平方分解：x^3 (x + 1)^2 = x^5 + 2x^4 + x^3
+    std::vector<PolynomialFactoring::Factor> parts = PolynomialFactoring::squareFreeDecomposition(dense({0, 0, 0, 1, 2, 1}));
+    ASSERT(parts.size() == 2 && parts[0].multiplicity == 2 && parts[1].multiplicity == 3, "Yun 无平方分解错误");
+
+    // 面向用户的因式分解与求根
+    Polynomial quintic("x^5-x");
+    std::cout << "x^5 - x = " << quintic.factor() << std::endl;
+    ASSERT(quintic.factor() == "x * (x + 1) * (x - 1) * (x^2 + 1)", "x^5-x 的因式分解输出错误");
+    std::vector<std::string> roots = quintic.solve_all_roots();
+    ASSERT((roots == std::vector<std::string>{"0", "-1", "1", "CANT_SOLVE", "CANT_SOLVE"}), "x^5-x 的根错误");
+
+    // 变量名保留在各因子上，一次因子首一、首项系数提为常数
+    Polynomial cubic("2*t^3+t^2-13*t+6");
+    std::cout << "2t^3 + t^2 - 13t + 6 = " << cubic.factor() << std::endl;
+    ASSERT(cubic.factor() == "2 * (t - 2) * (t + 3) * (t - 1/2)", "因子丢失变量名或顺序错误");
+
+    // 判别式为负的二次因子返回 CANT_SOLVE 而不是抛出异常
+    roots = Polynomial("x^2+x+1").solve_all_roots();
+    ASSERT((roots == std::vector<std::string>{"CANT_SOLVE", "CANT_SOLVE"}), "负判别式二次式应返回 CANT_SOLVE");
+    roots = Polynomial("x^6-1").solve_all_roots();
+    ASSERT((roots == std::vector<std::string>{"-1", "1", "CANT_SOLVE", "CANT_SOLVE", "CANT_SOLVE", "CANT_SOLVE"}),
+           "x^6-1 的根错误");
+
+    return true;
+}
+
+// 由表达式逐个填入多项式矩阵
+PolynomialMatrix polynomialMatrix(const std::vector<std::vector<std::string>>& rows)
+{
+    PolynomialMatrix m(rows.size(), rows.size());
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        for (size_t j = 0; j < rows[i].size(); ++j)
+        {
+            m.at(i, j) = Polynomial(rows[i][j]);
+        }
+    }
+    return m;
+}
+
+// 测试多项式矩阵行列式：求值/插值与代数余子式展开一致
+bool testPolynomialMatrixDeterminant()
+{
+    std::cout << "\n=== 测试多项式矩阵行列式 ===\n" << std::endl;
+
+    // 常数矩阵：次数界为 0，只需一个求值点
+    PolynomialMatrix constant = polynomialMatrix({{"2", "1", "0", "3"},
+                                                  {"1", "4", "1", "0"},
+                                                  {"0", "1", "5", "2"},
+                                                  {"3", "0", "2", "6"}});
+    ASSERT(constant.determinantByInterpolation().toString() == constant.determinantByExpansion().toString(),
+           "常数矩阵的插值行列式与展开不一致");
+
+    // 两行相同的奇异矩阵，行列式为零多项式
+    PolynomialMatrix singular = polynomialMatrix({{"x^2+1", "x", "2", "1"},
+                                                  {"1", "x-1", "x^3", "2"},
+                                                  {"x^2+1", "x", "2", "1"},
+                                                  {"3", "0", "x", "x^2"}});
+    ASSERT(singular.determinantByInterpolation().toString() == singular.determinantByExpansion().toString(),
+           "奇异矩阵的插值行列式与展开不一致");
+    ASSERT(singular.determinant().toString() == singular.determinantByExpansion().toString(), "奇异矩阵行列式应为 0");
+
+    // 各元素次数不同，按行与按列的次数界不同
+    PolynomialMatrix mixed = polynomialMatrix({{"x^3-2", "1", "0", "x", "1/2"},
+                                               {"2", "x^2+x", "3", "0", "1"},
+                                               {"0", "1", "x-3", "x^4", "2"},
+                                               {"1", "0", "2", "5", "x"},
+                                               {"x^2", "1/3", "0", "1", "7"}});
+    std::string expected = mixed.determinantByExpansion().toString();
+    std::cout << "5x5 混合次数矩阵的行列式: " << expected << std::endl;
+    ASSERT(mixed.determinantByInterpolation().toString() == expected, "混合次数矩阵的插值行列式与展开不一致");
+    // 阶数不低于 4 时 determinant() 默认走插值
+    ASSERT(mixed.determinant().toString() == expected, "determinant() 的默认路径结果错误");
+
+    return true;
+}
+
+// 测试有理多项式加减乘经由稠密形式的路径
+bool testDensePolynomialArithmetic()
+{
+    std::cout << "\n=== 测试稠密多项式运算 ===\n" << std::endl;
+    DensePolynomial out;
+
+    // 稀疏度界限：最高次数超过 4 * 项数 + 64 时留在单项式路径上
+    ASSERT(DensePolynomial::fromPolynomial(Polynomial("x^68"), out) && out.degree() == 68, "x^68 应转换为稠密形式");
+    ASSERT(!DensePolynomial::fromPolynomial(Polynomial("x^69"), out), "x^69 应留在单项式路径上");
+    ASSERT(DensePolynomial::fromPolynomial(Polynomial("x^72+1"), out), "两项时界限应为 72");
+    ASSERT(!DensePolynomial::fromPolynomial(Polynomial("x^73+1"), out), "x^73+1 应留在单项式路径上");
+    ASSERT(!DensePolynomial::fromPolynomial(Polynomial("x^(1/2)+1"), out), "分数次幂不能转换为稠密形式");
+
+    // 两条路径的结果一致
+    Polynomial sparse = Polynomial("x^200+1") * Polynomial("x^200-1");
+    std::cout << "(x^200 + 1)(x^200 - 1) = " << sparse.toString() << std::endl;
+    ASSERT(sparse.toString() == "x^400 - 1", "稀疏多项式乘法错误");
+    Polynomial product = Polynomial("x^2+2*x+1") * Polynomial("x-1");
+    ASSERT(product.toString() == "x^3 + x^2 - x - 1", "稠密多项式乘法错误");
+
+    // 结果为零多项式
+    Polynomial zero = Polynomial("x^2+3*x") - Polynomial("x^2+3*x");
+    ASSERT(zero.isEmpty() && zero.getDegree() == Fraction(-1) && zero.toString() == "0", "相减应得零多项式");
+    ASSERT((Polynomial("x^3-1") * zero).isEmpty(), "乘以零多项式应得零多项式");
+    ASSERT((zero + Polynomial("t")).toString() == "t", "零多项式加法错误");
+
+    // 一侧为常数时取另一侧的变量名
+    Polynomial scaled = Polynomial("3") * Polynomial("t+1");
+    std::cout << "3 * (t + 1) = " << scaled.toString() << std::endl;
+    ASSERT(scaled.getVariableName() == "t" && scaled.toString() == "3*t + 3", "常数在左时变量名错误");
+    ASSERT((Polynomial("t+1") - Polynomial("2")).getVariableName() == "t", "常数在右时变量名错误");
+    ASSERT((Polynomial("5") + Polynomial("y^2")).getVariableName() == "y", "常数加法的变量名错误");
+
+    return true;
+}
+
+int main()
+{
+    SetConsoleCP(65001);       // 设置控制台输入为UTF-8编码
+    SetConsoleOutputCP(65001); // 设置控制台输出为UTF-8编码
+    std::cout << "线性代数计算系统 - 第六阶段测试（多项式）\n"
+              << std::endl;
+
+    bool factoringTestPassed = testPolynomialFactoring();
+    bool determinantTestPassed = testPolynomialMatrixDeterminant();
+    bool arithmeticTestPassed = testDensePolynomialArithmetic();
+
+    std::cout << "\n=== 测试结果汇总 ===" << std::endl;
+    std::cout << "多项式因式分解测试: " << (factoringTestPassed ? "通过" : "失败") << std::endl;
+    std::cout << "多项式矩阵行列式测试: " << (determinantTestPassed ? "通过" : "失败") << std::endl;
+    std::cout << "稠密多项式运算测试: " << (arithmeticTestPassed ? "通过" : "失败") << std::endl;
+
+    return (factoringTestPassed && determinantTestPassed && arithmeticTestPassed) ? 0 : 1;
+}